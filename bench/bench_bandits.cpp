@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <map>
+#include <string>
+#include "../src/evalbandits.hpp"
+#include "bench_common.hpp"
+
+using namespace eppoclient;
+
+namespace {
+
+std::map<std::string, ContextAttributes> makeActions(size_t actionCount, size_t attributeCount) {
+    std::map<std::string, ContextAttributes> actions;
+    for (size_t action = 0; action < actionCount; ++action) {
+        actions["action-" + std::to_string(action)] =
+            bench::makeBanditActionAttributes(action, attributeCount);
+    }
+    return actions;
+}
+
+}  // namespace
+
+// Action count, attribute count per coefficient group
+static void BM_EvaluateBandit(benchmark::State& state) {
+    size_t actionCount = static_cast<size_t>(state.range(0));
+    size_t attributeCount = static_cast<size_t>(state.range(1));
+    BanditModelData modelData = bench::makeBanditModel(actionCount, attributeCount);
+    ContextAttributes subjectAttributes = bench::makeBanditSubjectAttributes(attributeCount);
+    auto actions = makeActions(actionCount, attributeCount);
+    BanditEvaluationContext context("bandit-flag", "subject-1", subjectAttributes, actions);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evaluateBandit(modelData, context));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_EvaluateBandit)->ArgsProduct({{2, 16, 128}, {2, 16}});
+
+// Action count, attribute count per coefficient group; also returns the top 5 actions
+static void BM_EvaluateBanditDistribution(benchmark::State& state) {
+    size_t actionCount = static_cast<size_t>(state.range(0));
+    size_t attributeCount = static_cast<size_t>(state.range(1));
+    BanditModelData modelData = bench::makeBanditModel(actionCount, attributeCount);
+    ContextAttributes subjectAttributes = bench::makeBanditSubjectAttributes(attributeCount);
+    auto actions = makeActions(actionCount, attributeCount);
+    BanditEvaluationContext context("bandit-flag", "subject-1", subjectAttributes, actions);
+    BanditActionDistribution distribution;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evaluateBandit(modelData, context, 5, distribution));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_EvaluateBanditDistribution)->ArgsProduct({{2, 16, 128}, {2, 16}});
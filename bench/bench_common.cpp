@@ -0,0 +1,128 @@
+#include "bench_common.hpp"
+
+namespace eppoclient {
+namespace bench {
+
+namespace {
+
+nlohmann::json makeSplitJson(const std::string& variationKey, const std::string& salt, int start,
+                             int end) {
+    return {{"variationKey", variationKey},
+            {"shards", {{{"salt", salt}, {"ranges", {{{"start", start}, {"end", end}}}}}}}};
+}
+
+}  // namespace
+
+nlohmann::json makeFlagJson(const std::string& flagKey, size_t allocationCount,
+                            size_t listSize) {
+    nlohmann::json countries = nlohmann::json::array();
+    for (size_t i = 0; i < listSize; ++i) {
+        countries.push_back("country-" + std::to_string(i));
+    }
+
+    nlohmann::json allocations = nlohmann::json::array();
+    for (size_t i = 0; i + 1 < allocationCount; ++i) {
+        nlohmann::json conditions = {
+            {{"attribute", "country"}, {"operator", "ONE_OF"}, {"value", countries}},
+            {{"attribute", "age"}, {"operator", "GTE"}, {"value", 18}}};
+        nlohmann::json split = {{"variationKey", "on"}, {"shards", nlohmann::json::array()}};
+        allocations.push_back({{"key", "targeted-" + std::to_string(i)},
+                               {"rules", {{{"conditions", conditions}}}},
+                               {"splits", {split}},
+                               {"doLog", true}});
+    }
+    std::string salt = flagKey + "-split";
+    allocations.push_back({{"key", "experiment"},
+                           {"splits",
+                            {makeSplitJson("control", salt, 0, 5000),
+                             makeSplitJson("on", salt, 5000, 10000)}},
+                           {"doLog", true}});
+
+    return {{"key", flagKey},
+            {"enabled", true},
+            {"variationType", "STRING"},
+            {"variations",
+             {{"control", {{"key", "control"}, {"value", "control"}}},
+              {"on", {{"key", "on"}, {"value", "on"}}}}},
+            {"allocations", allocations},
+            {"totalShards", 10000}};
+}
+
+nlohmann::json makeFlagsResponseJson(size_t flagCount, size_t allocationCount,
+                                     size_t listSize) {
+    nlohmann::json flags = nlohmann::json::object();
+    for (size_t i = 0; i < flagCount; ++i) {
+        std::string flagKey = "flag-" + std::to_string(i);
+        flags[flagKey] = makeFlagJson(flagKey, allocationCount, listSize);
+    }
+    return {{"createdAt", "2024-04-17T19:40:53.716Z"},
+            {"format", "SERVER"},
+            {"environment", {{"name", "Benchmark"}}},
+            {"flags", flags}};
+}
+
+Attributes makeUntargetedSubjectAttributes() {
+    return {{"country", std::string("untargeted")}, {"age", int64_t(30)}};
+}
+
+BanditModelData makeBanditModel(size_t actionCount, size_t attributeCount) {
+    BanditModelData modelData;
+    modelData.gamma = 1.0;
+    modelData.defaultActionScore = 0.0;
+    modelData.actionProbabilityFloor = 0.01;
+
+    for (size_t action = 0; action < actionCount; ++action) {
+        BanditCoefficients coefficients;
+        coefficients.actionKey = "action-" + std::to_string(action);
+        coefficients.intercept = 0.1 * static_cast<double>(action % 10);
+        for (size_t i = 0; i < attributeCount; ++i) {
+            std::string index = std::to_string(i);
+            double weight = 0.01 * static_cast<double>((action + i) % 7);
+
+            BanditNumericAttributeCoefficient numeric;
+            numeric.coefficient = weight;
+            numeric.missingValueCoefficient = -weight;
+            numeric.attributeKey = "subject-numeric-" + index;
+            coefficients.subjectNumericCoefficients.push_back(numeric);
+            numeric.attributeKey = "action-numeric-" + index;
+            coefficients.actionNumericCoefficients.push_back(numeric);
+
+            BanditCategoricalAttributeCoefficient categorical;
+            categorical.missingValueCoefficient = -weight;
+            categorical.valueCoefficients = {{"a", weight}, {"b", -weight}, {"c", 2 * weight}};
+            categorical.attributeKey = "subject-categorical-" + index;
+            coefficients.subjectCategoricalCoefficients.push_back(categorical);
+            categorical.attributeKey = "action-categorical-" + index;
+            coefficients.actionCategoricalCoefficients.push_back(categorical);
+        }
+        modelData.coefficients[coefficients.actionKey] = coefficients;
+    }
+
+    modelData.precompute();
+    return modelData;
+}
+
+ContextAttributes makeBanditSubjectAttributes(size_t attributeCount) {
+    ContextAttributes attributes;
+    for (size_t i = 0; i < attributeCount; ++i) {
+        std::string index = std::to_string(i);
+        attributes.numericAttributes["subject-numeric-" + index] = static_cast<double>(i);
+        attributes.categoricalAttributes["subject-categorical-" + index] = i % 2 == 0 ? "a" : "b";
+    }
+    return attributes;
+}
+
+ContextAttributes makeBanditActionAttributes(size_t action, size_t attributeCount) {
+    static const char* const kValues[] = {"a", "b", "c", "d"};
+    ContextAttributes attributes;
+    for (size_t i = 0; i < attributeCount; ++i) {
+        std::string index = std::to_string(i);
+        attributes.numericAttributes["action-numeric-" + index] =
+            static_cast<double>((action * 31 + i) % 100);
+        attributes.categoricalAttributes["action-categorical-" + index] = kValues[(action + i) % 4];
+    }
+    return attributes;
+}
+
+}  // namespace bench
+}  // namespace eppoclient
@@ -0,0 +1,40 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <string>
+#include "../src/evalbandits.hpp"
+#include "../src/rules.hpp"
+
+namespace eppoclient {
+namespace bench {
+
+// JSON of a string flag with allocationCount allocations. Every allocation but the
+// last targets subjects whose "country" is one of listSize values and whose "age"
+// is at least 18; the last one splits every subject across two variations.
+nlohmann::json makeFlagJson(const std::string& flagKey, size_t allocationCount,
+                            size_t listSize);
+
+// JSON of a flag configuration response with flagCount flags like makeFlagJson()'s
+nlohmann::json makeFlagsResponseJson(size_t flagCount, size_t allocationCount,
+                                     size_t listSize);
+
+// Attributes of a subject that matches no targeted allocation of makeFlagJson()'s
+// flags, so every allocation is evaluated
+Attributes makeUntargetedSubjectAttributes();
+
+// Compiled bandit model with actionCount actions, each with attributeCount numeric
+// and categorical coefficients for subject and action attributes
+BanditModelData makeBanditModel(size_t actionCount, size_t attributeCount);
+
+// Subject attributes for makeBanditModel()'s models
+ContextAttributes makeBanditSubjectAttributes(size_t attributeCount);
+
+// Action attributes for makeBanditModel()'s models
+ContextAttributes makeBanditActionAttributes(size_t action, size_t attributeCount);
+
+}  // namespace bench
+}  // namespace eppoclient
+
+#endif  // BENCH_COMMON_HPP
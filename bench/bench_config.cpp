@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "../src/config_response.hpp"
+#include "bench_common.hpp"
+
+using namespace eppoclient;
+
+// Flag count, ONE_OF list size; each flag has 4 allocations
+static void BM_ParseConfigResponse(benchmark::State& state) {
+    std::string json = bench::makeFlagsResponseJson(static_cast<size_t>(state.range(0)), 4,
+                                                    static_cast<size_t>(state.range(1)))
+                           .dump();
+    for (auto _ : state) {
+        auto result = parseConfigResponse(json);
+        if (!result.hasValue()) {
+            state.SkipWithError("failed to parse the flag configuration");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_ParseConfigResponse)
+    ->ArgsProduct({{10, 100, 1000}, {10, 1000}})
+    ->Unit(benchmark::kMillisecond);
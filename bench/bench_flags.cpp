@@ -0,0 +1,236 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../src/client.hpp"
+#include "../src/config_response.hpp"
+#include "../src/configuration.hpp"
+#include "../src/evalflags.hpp"
+#include "../src/evaluation_client.hpp"
+#include "../src/rules.hpp"
+#include "../src/subject_context.hpp"
+#include "bench_common.hpp"
+
+using namespace eppoclient;
+
+namespace {
+
+// Subject keys cycled through by evaluation benchmarks, so shards vary between iterations
+std::vector<std::string> makeSubjectKeys() {
+    std::vector<std::string> subjectKeys;
+    for (int i = 0; i < 1024; ++i) {
+        subjectKeys.push_back("subject-" + std::to_string(i));
+    }
+    return subjectKeys;
+}
+
+Condition makeCondition(Operator op, const nlohmann::json& value) {
+    Condition condition;
+    condition.op = op;
+    condition.attribute = "attribute";
+    condition.value = value;
+    condition.precompute();
+    return condition;
+}
+
+nlohmann::json makeStringList(size_t size) {
+    nlohmann::json values = nlohmann::json::array();
+    for (size_t i = 0; i < size; ++i) {
+        values.push_back("value-" + std::to_string(i));
+    }
+    return values;
+}
+
+// Parse a configuration with a single flag "flag-0" like makeFlagJson()'s
+Configuration makeFlagConfiguration(size_t allocationCount, size_t listSize) {
+    auto result =
+        parseConfiguration(bench::makeFlagsResponseJson(1, allocationCount, listSize).dump());
+    return result.hasValue() ? std::move(*result.value) : Configuration();
+}
+
+// Parse a configuration with flagCount string flags "email-flag-<i>", each with one
+// allocation per pattern targeting subjects whose "email" matches a distinct
+// pattern, so the "email" pattern set holds flagCount * patternsPerFlag patterns
+Configuration makeRegexFlagConfiguration(size_t flagCount, size_t patternsPerFlag) {
+    nlohmann::json flags = nlohmann::json::object();
+    for (size_t f = 0; f < flagCount; ++f) {
+        nlohmann::json allocations = nlohmann::json::array();
+        for (size_t i = 0; i < patternsPerFlag; ++i) {
+            std::string domain = "domain-" + std::to_string(f) + "-" + std::to_string(i);
+            nlohmann::json condition = {{"attribute", "email"},
+                                        {"operator", "MATCHES"},
+                                        {"value", "@" + domain + "\\.com$"}};
+            allocations.push_back(
+                {{"key", domain},
+                 {"rules", {{{"conditions", {condition}}}}},
+                 {"splits", {{{"variationKey", "on"}, {"shards", nlohmann::json::array()}}}},
+                 {"doLog", false}});
+        }
+        std::string flagKey = "email-flag-" + std::to_string(f);
+        flags[flagKey] = {{"key", flagKey},
+                          {"enabled", true},
+                          {"variationType", "STRING"},
+                          {"variations", {{"on", {{"key", "on"}, {"value", "on"}}}}},
+                          {"allocations", allocations},
+                          {"totalShards", 10000}};
+    }
+    auto result = parseConfiguration(nlohmann::json({{"flags", flags}}).dump());
+    return result.hasValue() ? std::move(*result.value) : Configuration();
+}
+
+// Attributes of a subject whose email matches none of makeRegexFlagConfiguration()'s
+// patterns, so every allocation is evaluated
+Attributes makeRegexSubjectAttributes() {
+    Attributes attributes = bench::makeUntargetedSubjectAttributes();
+    attributes["email"] = std::string("someone@example.com");
+    return attributes;
+}
+
+}  // namespace
+
+// Input length
+static void BM_GetShard(benchmark::State& state) {
+    std::string input(static_cast<size_t>(state.range(0)), 'x');
+    int64_t shard = 0;
+    for (auto _ : state) {
+        shard += getShard(input, 10000);
+        benchmark::DoNotOptimize(shard);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_GetShard)->RangeMultiplier(8)->Range(8, 512);
+
+static void BM_ConditionMatches(benchmark::State& state, Operator op, nlohmann::json value,
+                                AttributeValue subjectValue) {
+    Condition condition = makeCondition(op, value);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(internal::conditionMatches(condition, &subjectValue));
+    }
+}
+BENCHMARK_CAPTURE(BM_ConditionMatches, is_null, Operator::IS_NULL, true,
+                  AttributeValue(std::monostate()));
+BENCHMARK_CAPTURE(BM_ConditionMatches, matches, Operator::MATCHES, "@example\\.com$",
+                  AttributeValue(std::string("someone@example.com")));
+BENCHMARK_CAPTURE(BM_ConditionMatches, not_matches, Operator::NOT_MATCHES, "^[0-9]+$",
+                  AttributeValue(std::string("subject-12345")));
+BENCHMARK_CAPTURE(BM_ConditionMatches, gte, Operator::GTE, 18, AttributeValue(int64_t(30)));
+BENCHMARK_CAPTURE(BM_ConditionMatches, gt, Operator::GT, 18.5, AttributeValue(30.0));
+BENCHMARK_CAPTURE(BM_ConditionMatches, lte, Operator::LTE, 100,
+                  AttributeValue(std::string("42")));
+BENCHMARK_CAPTURE(BM_ConditionMatches, lt_semver, Operator::LT, "2.10.0",
+                  AttributeValue(std::string("2.9.3")));
+
+// List size; the subject value is not in the list
+static void BM_ConditionMatchesList(benchmark::State& state, Operator op) {
+    Condition condition = makeCondition(op, makeStringList(static_cast<size_t>(state.range(0))));
+    AttributeValue subjectValue = std::string("missing-value");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(internal::conditionMatches(condition, &subjectValue));
+    }
+}
+BENCHMARK_CAPTURE(BM_ConditionMatchesList, one_of, Operator::ONE_OF)
+    ->RangeMultiplier(10)
+    ->Range(1, 10000);
+BENCHMARK_CAPTURE(BM_ConditionMatchesList, not_one_of, Operator::NOT_ONE_OF)
+    ->RangeMultiplier(10)
+    ->Range(1, 10000);
+
+// Allocation count, ONE_OF list size; every allocation is evaluated
+static void BM_EvalFlag(benchmark::State& state) {
+    Configuration configuration = makeFlagConfiguration(static_cast<size_t>(state.range(0)),
+                                                        static_cast<size_t>(state.range(1)));
+    const FlagConfiguration* flag = configuration.getFlagConfiguration("flag-0");
+    if (flag == nullptr) {
+        state.SkipWithError("failed to parse the flag configuration");
+        return;
+    }
+    std::vector<std::string> subjectKeys = makeSubjectKeys();
+    Attributes attributes = bench::makeUntargetedSubjectAttributes();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& subjectKey = subjectKeys[i++ % subjectKeys.size()];
+        benchmark::DoNotOptimize(evalFlag(*flag, subjectKey, attributes));
+    }
+}
+BENCHMARK(BM_EvalFlag)->ArgsProduct({{1, 8, 64}, {10, 1000}});
+
+// Allocation count, ONE_OF list size; the subject's attributes are resolved once
+static void BM_EvalFlagSubjectContext(benchmark::State& state) {
+    Configuration configuration = makeFlagConfiguration(static_cast<size_t>(state.range(0)),
+                                                        static_cast<size_t>(state.range(1)));
+    const FlagConfiguration* flag = configuration.getFlagConfiguration("flag-0");
+    if (flag == nullptr) {
+        state.SkipWithError("failed to parse the flag configuration");
+        return;
+    }
+    Attributes attributes = bench::makeUntargetedSubjectAttributes();
+    SubjectContext subject(configuration, "subject-1", attributes);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evalFlag(*flag, subject));
+    }
+}
+BENCHMARK(BM_EvalFlagSubjectContext)->ArgsProduct({{1, 8, 64}, {10, 1000}});
+
+// Allocation count, ONE_OF list size
+static void BM_EvalFlagDetails(benchmark::State& state) {
+    Configuration configuration = makeFlagConfiguration(static_cast<size_t>(state.range(0)),
+                                                        static_cast<size_t>(state.range(1)));
+    const FlagConfiguration* flag = configuration.getFlagConfiguration("flag-0");
+    if (flag == nullptr) {
+        state.SkipWithError("failed to parse the flag configuration");
+        return;
+    }
+    std::vector<std::string> subjectKeys = makeSubjectKeys();
+    Attributes attributes = bench::makeUntargetedSubjectAttributes();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& subjectKey = subjectKeys[i++ % subjectKeys.size()];
+        benchmark::DoNotOptimize(evalFlagDetails(*flag, subjectKey, attributes));
+    }
+}
+BENCHMARK(BM_EvalFlagDetails)->ArgsProduct({{1, 8, 64}, {10, 1000}});
+
+// Flag count, patterns per flag; a plain attribute map evaluated through the client
+// getter, which only resolves it against the configuration when that pays off
+static void BM_GetAssignmentAttributes(benchmark::State& state) {
+    Configuration configuration = makeRegexFlagConfiguration(static_cast<size_t>(state.range(0)),
+                                                             static_cast<size_t>(state.range(1)));
+    NoOpAssignmentLogger assignmentLogger;
+    NoOpBanditLogger banditLogger;
+    NoOpApplicationLogger applicationLogger;
+    EvaluationClient client(configuration, assignmentLogger, banditLogger, applicationLogger);
+    std::vector<std::string> subjectKeys = makeSubjectKeys();
+    Attributes attributes = makeRegexSubjectAttributes();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& subjectKey = subjectKeys[i++ % subjectKeys.size()];
+        benchmark::DoNotOptimize(
+            client.getStringAssignment("email-flag-0", subjectKey, attributes, "off"));
+    }
+}
+BENCHMARK(BM_GetAssignmentAttributes)->ArgsProduct({{1, 8, 64}, {1, 2, 8, 64}});
+
+// Flag count, patterns per flag; the same evaluation, always resolving the attributes
+// against the configuration, for comparison with the plain path
+static void BM_GetAssignmentResolvedAttributes(benchmark::State& state) {
+    Configuration configuration = makeRegexFlagConfiguration(static_cast<size_t>(state.range(0)),
+                                                             static_cast<size_t>(state.range(1)));
+    NoOpAssignmentLogger assignmentLogger;
+    NoOpBanditLogger banditLogger;
+    NoOpApplicationLogger applicationLogger;
+    EvaluationClient client(configuration, assignmentLogger, banditLogger, applicationLogger);
+    std::vector<std::string> subjectKeys = makeSubjectKeys();
+    Attributes attributes = makeRegexSubjectAttributes();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& subjectKey = subjectKeys[i++ % subjectKeys.size()];
+        SubjectContext subject(configuration, subjectKey, attributes);
+        benchmark::DoNotOptimize(client.getStringAssignment("email-flag-0", subject, "off"));
+    }
+}
+BENCHMARK(BM_GetAssignmentResolvedAttributes)->ArgsProduct({{1, 8, 64}, {1, 2, 8, 64}});
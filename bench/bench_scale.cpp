@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "../src/config_response.hpp"
+#include "../src/configuration.hpp"
+#include "../src/evalbandits.hpp"
+#include "../src/evalflags.hpp"
+#include "config_generator.hpp"
+
+using namespace eppoclient;
+
+// Benchmarks over generated production-sized configurations
+
+namespace {
+
+bench::ConfigGeneratorOptions makeOptions(benchmark::State& state) {
+    bench::ConfigGeneratorOptions options;
+    options.flagCount = static_cast<size_t>(state.range(0));
+    options.maxAllocations = static_cast<size_t>(state.range(1));
+    options.maxListSize = 1000;
+    options.banditCount = 1;
+    options.actionsPerBandit = 20;
+    return options;
+}
+
+}  // namespace
+
+// Flag count, maximum allocations per flag
+static void BM_ParseGeneratedConfiguration(benchmark::State& state) {
+    bench::ConfigGeneratorOptions options = makeOptions(state);
+    std::string flagsJson = bench::generateFlagsJson(options).dump();
+    std::string banditsJson = bench::generateBanditModelsJson(options).dump();
+
+    for (auto _ : state) {
+        auto result = parseConfiguration(flagsJson, banditsJson);
+        if (!result.hasValue() || result.hasErrors()) {
+            state.SkipWithError("failed to parse the generated configuration");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(flagsJson.size() + banditsJson.size()));
+    state.counters["json_bytes"] = static_cast<double>(flagsJson.size() + banditsJson.size());
+}
+BENCHMARK(BM_ParseGeneratedConfiguration)
+    ->ArgsProduct({{100, 1000, 8000}, {10, 50}})
+    ->Unit(benchmark::kMillisecond);
+
+// Flag count, maximum allocations per flag; evaluates every flag for one subject
+static void BM_EvaluateGeneratedFlags(benchmark::State& state) {
+    bench::ConfigGeneratorOptions options = makeOptions(state);
+    auto result = parseConfiguration(bench::generateFlagsJson(options).dump());
+    if (!result.hasValue()) {
+        state.SkipWithError("failed to parse the generated configuration");
+        return;
+    }
+    const Configuration& configuration = *result.value;
+
+    std::vector<const FlagConfiguration*> flags;
+    for (size_t i = 0; i < options.flagCount; ++i) {
+        flags.push_back(configuration.getFlagConfiguration("flag-" + std::to_string(i)));
+    }
+    std::vector<std::string> subjectKeys;
+    std::vector<Attributes> subjectAttributes;
+    for (uint64_t i = 0; i < 64; ++i) {
+        subjectKeys.push_back("subject-" + std::to_string(i));
+        subjectAttributes.push_back(bench::generateSubjectAttributes(options, i));
+    }
+
+    size_t subject = 0;
+    for (auto _ : state) {
+        size_t s = subject++ % subjectKeys.size();
+        for (const FlagConfiguration* flag : flags) {
+            benchmark::DoNotOptimize(evalFlag(*flag, subjectKeys[s], subjectAttributes[s]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(flags.size()));
+}
+BENCHMARK(BM_EvaluateGeneratedFlags)
+    ->ArgsProduct({{100, 1000, 8000}, {10, 50}})
+    ->Unit(benchmark::kMillisecond);
+
+// Actions per bandit, coefficients per attribute group
+static void BM_EvaluateGeneratedBandit(benchmark::State& state) {
+    bench::ConfigGeneratorOptions options;
+    options.flagCount = 0;
+    options.banditCount = 1;
+    options.actionsPerBandit = static_cast<size_t>(state.range(0));
+    options.attributesPerAction = static_cast<size_t>(state.range(1));
+    auto result = parseBanditResponse(bench::generateBanditModelsJson(options));
+    if (!result.hasValue() || result.value->bandits.empty()) {
+        state.SkipWithError("failed to parse the generated bandit models");
+        return;
+    }
+    const BanditModelData& modelData = result.value->bandits.begin()->second.modelData;
+
+    ContextAttributes subjectAttributes = bench::generateBanditSubjectAttributes(options, 0);
+    auto actions = bench::generateBanditActions(options, 0);
+    BanditEvaluationContext context("bandit-flag-0", "subject-0", subjectAttributes, actions);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evaluateBandit(modelData, context));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_EvaluateGeneratedBandit)->ArgsProduct({{10, 100, 1000}, {4, 32}});
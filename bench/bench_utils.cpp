@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../src/lru2q.hpp"
+#include "../src/time_utils.hpp"
+
+using namespace eppoclient;
+
+namespace {
+
+std::vector<std::string> makeKeys(size_t count) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < count; ++i) {
+        keys.push_back("flag-" + std::to_string(i % 100) + "/subject-" + std::to_string(i));
+    }
+    return keys;
+}
+
+}  // namespace
+
+// Cache capacity; a hit on every lookup
+static void BM_TwoQueueCacheGetHit(benchmark::State& state) {
+    size_t capacity = static_cast<size_t>(state.range(0));
+    cache::TwoQueueCache<std::string, std::string> cache(capacity);
+    std::vector<std::string> keys = makeKeys(capacity / 2);
+    for (const auto& key : keys) {
+        cache.Add(key, "variation");
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.Get(keys[i++ % keys.size()]));
+    }
+}
+BENCHMARK(BM_TwoQueueCacheGetHit)->RangeMultiplier(16)->Range(16, 65536);
+
+// Cache capacity; adds twice as many distinct keys as fit, evicting on most adds
+static void BM_TwoQueueCacheAddEvict(benchmark::State& state) {
+    size_t capacity = static_cast<size_t>(state.range(0));
+    cache::TwoQueueCache<std::string, std::string> cache(capacity);
+    std::vector<std::string> keys = makeKeys(capacity * 2);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        cache.Add(keys[i++ % keys.size()], "variation");
+    }
+}
+BENCHMARK(BM_TwoQueueCacheAddEvict)->RangeMultiplier(16)->Range(16, 65536);
+
+static void BM_FormatISOTimestamp(benchmark::State& state) {
+    auto now = std::chrono::system_clock::now();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(formatISOTimestamp(now));
+    }
+}
+BENCHMARK(BM_FormatISOTimestamp);
@@ -0,0 +1,396 @@
+#include "config_generator.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace eppoclient {
+namespace bench {
+
+namespace {
+
+constexpr const char* kTimestamp = "2024-04-17T19:40:53.716Z";
+constexpr int kTotalShards = 10000;
+
+// Values of string attributes are "value-<n>" with n below this multiple of the
+// maximum list size, so a ONE_OF list matches a fraction of subjects
+constexpr size_t kStringValueRange = 2;
+
+// Independent random streams derived from the seed
+enum class Stream : uint64_t { FLAG = 1, BANDIT = 2, SUBJECT = 3, BANDIT_SUBJECT = 4 };
+
+// SplitMix64: small, fast, and identical on every platform
+class Random {
+public:
+    Random(uint64_t seed, Stream stream, uint64_t index)
+        : state_(seed ^ (static_cast<uint64_t>(stream) << 56)) {
+        state_ = next() ^ index;
+        next();
+    }
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, n); n must be positive
+    size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+
+    // Uniform in [min, max]
+    size_t between(size_t min, size_t max) { return max <= min ? min : min + below(max - min + 1); }
+
+    // Uniform in [0, 1)
+    double unit() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    bool chance(double probability) { return unit() < probability; }
+
+    // In [min, max], choosing a power-of-two band of the range first so that
+    // small values are more likely than large ones
+    size_t skewed(size_t min, size_t max) {
+        if (max <= min) {
+            return min;
+        }
+        size_t span = max - min;
+        size_t bits = 0;
+        while ((span >> bits) != 0) {
+            ++bits;
+        }
+        size_t band = below(bits + 1);
+        size_t limit = band == 0 ? 0 : std::min(span, (size_t(1) << band) - 1);
+        return min + between(0, limit);
+    }
+
+private:
+    uint64_t state_;
+};
+
+enum class AttributeKind { STRING, NUMERIC, VERSION };
+
+size_t attributesPerKind(const ConfigGeneratorOptions& options) {
+    return std::max<size_t>(1, (options.attributeCount + 2) / 3);
+}
+
+std::string attributeName(AttributeKind kind, size_t index) {
+    switch (kind) {
+        case AttributeKind::STRING:
+            return "str-" + std::to_string(index);
+        case AttributeKind::NUMERIC:
+            return "num-" + std::to_string(index);
+        case AttributeKind::VERSION:
+        default:
+            return "ver-" + std::to_string(index);
+    }
+}
+
+std::string randomAttribute(Random& random, const ConfigGeneratorOptions& options,
+                            AttributeKind kind) {
+    return attributeName(kind, random.below(attributesPerKind(options)));
+}
+
+std::string randomVersion(Random& random) {
+    return "1." + std::to_string(random.below(10)) + "." + std::to_string(random.below(10));
+}
+
+const char* randomComparison(Random& random) {
+    static const char* const kOperators[] = {"GT", "GTE", "LT", "LTE"};
+    return kOperators[random.below(4)];
+}
+
+std::string randomPattern(Random& random) {
+    std::string digits = std::to_string(random.below(100));
+    switch (random.below(4)) {
+        case 0:
+            return "^value-" + digits;
+        case 1:
+            return digits + "$";
+        case 2:
+            return "^value-[0-9]*" + digits + "[0-9]*$";
+        default:
+            return "(?i)VALUE-" + digits;
+    }
+}
+
+nlohmann::json makeCondition(const std::string& attribute, const char* op,
+                             const nlohmann::json& value) {
+    return {{"attribute", attribute}, {"operator", op}, {"value", value}};
+}
+
+nlohmann::json generateCondition(Random& random, const ConfigGeneratorOptions& options) {
+    const ConditionMix& mix = options.conditionMix;
+    double total = mix.oneOf + mix.numeric + mix.semVer + mix.regex + mix.isNull;
+    double pick = random.unit() * (total > 0 ? total : 1.0);
+
+    if ((pick -= mix.oneOf) < 0 || total <= 0) {
+        size_t listSize = random.skewed(options.minListSize, options.maxListSize);
+        size_t base = random.below(std::max<size_t>(1, options.maxListSize));
+        nlohmann::json values = nlohmann::json::array();
+        for (size_t i = 0; i < listSize; ++i) {
+            values.push_back("value-" + std::to_string(base + i));
+        }
+        const char* op = random.chance(0.25) ? "NOT_ONE_OF" : "ONE_OF";
+        return makeCondition(randomAttribute(random, options, AttributeKind::STRING), op, values);
+    }
+    if ((pick -= mix.numeric) < 0) {
+        return makeCondition(randomAttribute(random, options, AttributeKind::NUMERIC),
+                             randomComparison(random), random.below(100));
+    }
+    if ((pick -= mix.semVer) < 0) {
+        return makeCondition(randomAttribute(random, options, AttributeKind::VERSION),
+                             randomComparison(random), randomVersion(random));
+    }
+    if ((pick -= mix.regex) < 0) {
+        const char* op = random.chance(0.25) ? "NOT_MATCHES" : "MATCHES";
+        return makeCondition(randomAttribute(random, options, AttributeKind::STRING), op,
+                             randomPattern(random));
+    }
+    AttributeKind kind = static_cast<AttributeKind>(random.below(3));
+    return makeCondition(randomAttribute(random, options, kind), "IS_NULL", random.chance(0.5));
+}
+
+// Splits of an allocation, dividing every shard between the variations
+nlohmann::json generateSplits(const std::vector<std::string>& variationKeys,
+                              const std::string& salt) {
+    nlohmann::json splits = nlohmann::json::array();
+    size_t count = variationKeys.size();
+    for (size_t i = 0; i < count; ++i) {
+        int start = static_cast<int>(kTotalShards * i / count);
+        int end = static_cast<int>(kTotalShards * (i + 1) / count);
+        nlohmann::json range = {{"start", start}, {"end", end}};
+        nlohmann::json shard = {{"salt", salt}, {"ranges", {range}}};
+        splits.push_back({{"variationKey", variationKeys[i]}, {"shards", {shard}}});
+    }
+    return splits;
+}
+
+nlohmann::json generateFlag(Random& random, const ConfigGeneratorOptions& options,
+                            const std::string& flagKey) {
+    static const char* const kTypes[] = {"STRING", "INTEGER", "NUMERIC", "BOOLEAN", "JSON"};
+    std::string variationType = kTypes[random.below(5)];
+
+    size_t variationCount =
+        variationType == "BOOLEAN" ? 2 : std::max<size_t>(1, options.variationsPerFlag);
+    nlohmann::json variations = nlohmann::json::object();
+    std::vector<std::string> variationKeys;
+    for (size_t i = 0; i < variationCount; ++i) {
+        std::string key = "variation-" + std::to_string(i);
+        nlohmann::json value;
+        if (variationType == "STRING") {
+            value = key;
+        } else if (variationType == "INTEGER") {
+            value = static_cast<int64_t>(i);
+        } else if (variationType == "NUMERIC") {
+            value = static_cast<double>(i) + 0.5;
+        } else if (variationType == "BOOLEAN") {
+            value = i == 0;
+        } else {
+            value = nlohmann::json{{"variant", key}, {"index", i}}.dump();
+        }
+        variations[key] = {{"key", key}, {"value", value}};
+        variationKeys.push_back(key);
+    }
+
+    size_t allocationCount = random.skewed(std::max<size_t>(1, options.minAllocations),
+                                           std::max<size_t>(1, options.maxAllocations));
+    nlohmann::json allocations = nlohmann::json::array();
+    for (size_t a = 0; a < allocationCount; ++a) {
+        std::string allocationKey = "allocation-" + std::to_string(a);
+        nlohmann::json allocation = {{"key", allocationKey}, {"doLog", true}};
+        if (a + 1 < allocationCount) {
+            nlohmann::json rules = nlohmann::json::array();
+            for (size_t r = 0; r < options.rulesPerAllocation; ++r) {
+                nlohmann::json conditions = nlohmann::json::array();
+                for (size_t c = 0; c < options.conditionsPerRule; ++c) {
+                    conditions.push_back(generateCondition(random, options));
+                }
+                rules.push_back({{"conditions", conditions}});
+            }
+            allocation["rules"] = rules;
+        }
+        allocation["splits"] = generateSplits(variationKeys, flagKey + "-" + allocationKey);
+        allocations.push_back(allocation);
+    }
+
+    return {{"key", flagKey},
+            {"enabled", true},
+            {"variationType", variationType},
+            {"variations", variations},
+            {"allocations", allocations},
+            {"totalShards", kTotalShards}};
+}
+
+std::string banditKey(size_t index) {
+    return "bandit-" + std::to_string(index);
+}
+
+std::string actionKey(size_t index) {
+    return "action-" + std::to_string(index);
+}
+
+std::string categoryValue(size_t index) {
+    return "category-" + std::to_string(index);
+}
+
+// A coefficient in [-1, 1], in thousandths so it prints the same everywhere
+double randomCoefficient(Random& random) {
+    return static_cast<double>(static_cast<int>(random.below(2001)) - 1000) / 1000.0;
+}
+
+nlohmann::json generateNumericCoefficients(Random& random, const std::string& prefix,
+                                           size_t count) {
+    nlohmann::json coefficients = nlohmann::json::array();
+    for (size_t i = 0; i < count; ++i) {
+        coefficients.push_back({{"attributeKey", prefix + std::to_string(i)},
+                                {"coefficient", randomCoefficient(random)},
+                                {"missingValueCoefficient", randomCoefficient(random)}});
+    }
+    return coefficients;
+}
+
+nlohmann::json generateCategoricalCoefficients(Random& random, const std::string& prefix,
+                                               size_t count) {
+    nlohmann::json coefficients = nlohmann::json::array();
+    for (size_t i = 0; i < count; ++i) {
+        nlohmann::json valueCoefficients = nlohmann::json::object();
+        for (size_t v = 0; v < 4; ++v) {
+            valueCoefficients[categoryValue(v)] = randomCoefficient(random);
+        }
+        coefficients.push_back({{"attributeKey", prefix + std::to_string(i)},
+                                {"valueCoefficients", valueCoefficients},
+                                {"missingValueCoefficient", randomCoefficient(random)}});
+    }
+    return coefficients;
+}
+
+}  // namespace
+
+nlohmann::json generateFlagsJson(const ConfigGeneratorOptions& options) {
+    // Each flag has its own stream, so changing the flag count keeps the other flags
+    nlohmann::json flags = nlohmann::json::object();
+    for (size_t i = 0; i < options.flagCount; ++i) {
+        Random random(options.seed, Stream::FLAG, i);
+        std::string flagKey = "flag-" + std::to_string(i);
+        flags[flagKey] = generateFlag(random, options, flagKey);
+    }
+
+    nlohmann::json bandits = nlohmann::json::object();
+    for (size_t i = 0; i < options.banditCount; ++i) {
+        std::string key = banditKey(i);
+        std::string flagKey = "bandit-flag-" + std::to_string(i);
+        nlohmann::json variation = {{"key", key}, {"value", key}};
+        nlohmann::json split = {{"variationKey", key}, {"shards", nlohmann::json::array()}};
+        nlohmann::json allocation = {{"key", "bandit"}, {"splits", {split}}, {"doLog", true}};
+        flags[flagKey] = {{"key", flagKey},
+                          {"enabled", true},
+                          {"variationType", "STRING"},
+                          {"variations", {{key, variation}}},
+                          {"allocations", {allocation}},
+                          {"totalShards", kTotalShards}};
+        bandits[key] = {{{"key", key},
+                         {"flagKey", flagKey},
+                         {"variationKey", key},
+                         {"variationValue", key}}};
+    }
+
+    nlohmann::json response = {{"createdAt", kTimestamp},
+                               {"format", "SERVER"},
+                               {"environment", {{"name", "Generated"}}},
+                               {"flags", flags}};
+    if (!bandits.empty()) {
+        response["bandits"] = bandits;
+    }
+    return response;
+}
+
+nlohmann::json generateBanditModelsJson(const ConfigGeneratorOptions& options) {
+    nlohmann::json bandits = nlohmann::json::object();
+    for (size_t i = 0; i < options.banditCount; ++i) {
+        Random random(options.seed, Stream::BANDIT, i);
+        size_t attributeCount = options.attributesPerAction;
+
+        nlohmann::json coefficients = nlohmann::json::object();
+        for (size_t a = 0; a < options.actionsPerBandit; ++a) {
+            std::string key = actionKey(a);
+            coefficients[key] = {
+                {"actionKey", key},
+                {"intercept", randomCoefficient(random)},
+                {"subjectNumericCoefficients",
+                 generateNumericCoefficients(random, "subject-num-", attributeCount)},
+                {"subjectCategoricalCoefficients",
+                 generateCategoricalCoefficients(random, "subject-cat-", attributeCount)},
+                {"actionNumericCoefficients",
+                 generateNumericCoefficients(random, "action-num-", attributeCount)},
+                {"actionCategoricalCoefficients",
+                 generateCategoricalCoefficients(random, "action-cat-", attributeCount)}};
+        }
+
+        std::string key = banditKey(i);
+        bandits[key] = {{"banditKey", key},
+                        {"modelName", "falcon"},
+                        {"modelVersion", "v1"},
+                        {"updatedAt", kTimestamp},
+                        {"modelData",
+                         {{"gamma", 1.0},
+                          {"defaultActionScore", 0.0},
+                          {"actionProbabilityFloor", 0.0},
+                          {"coefficients", coefficients}}}};
+    }
+    return {{"updatedAt", kTimestamp}, {"bandits", bandits}};
+}
+
+Attributes generateSubjectAttributes(const ConfigGeneratorOptions& options,
+                                     uint64_t subjectIndex) {
+    Random random(options.seed, Stream::SUBJECT, subjectIndex);
+    size_t valueRange = std::max<size_t>(1, options.maxListSize * kStringValueRange);
+
+    // About one attribute in ten is missing, for IS_NULL conditions
+    Attributes attributes;
+    for (size_t i = 0; i < attributesPerKind(options); ++i) {
+        if (!random.chance(0.1)) {
+            attributes[attributeName(AttributeKind::STRING, i)] =
+                "value-" + std::to_string(random.below(valueRange));
+        }
+        if (!random.chance(0.1)) {
+            int64_t number = static_cast<int64_t>(random.below(100));
+            attributes[attributeName(AttributeKind::NUMERIC, i)] =
+                i % 2 == 0 ? AttributeValue(number) : AttributeValue(static_cast<double>(number));
+        }
+        if (!random.chance(0.1)) {
+            attributes[attributeName(AttributeKind::VERSION, i)] = randomVersion(random);
+        }
+    }
+    return attributes;
+}
+
+ContextAttributes generateBanditSubjectAttributes(const ConfigGeneratorOptions& options,
+                                                  uint64_t subjectIndex) {
+    Random random(options.seed, Stream::BANDIT_SUBJECT, subjectIndex);
+    ContextAttributes attributes;
+    for (size_t i = 0; i < options.attributesPerAction; ++i) {
+        std::string index = std::to_string(i);
+        attributes.numericAttributes["subject-num-" + index] =
+            static_cast<double>(random.below(1000)) / 10.0;
+        attributes.categoricalAttributes["subject-cat-" + index] = categoryValue(random.below(5));
+    }
+    return attributes;
+}
+
+std::map<std::string, ContextAttributes> generateBanditActions(
+    const ConfigGeneratorOptions& options, uint64_t subjectIndex) {
+    Random random(options.seed, Stream::BANDIT_SUBJECT, ~subjectIndex);
+    std::map<std::string, ContextAttributes> actions;
+    for (size_t a = 0; a < options.actionsPerBandit; ++a) {
+        ContextAttributes& attributes = actions[actionKey(a)];
+        for (size_t i = 0; i < options.attributesPerAction; ++i) {
+            std::string index = std::to_string(i);
+            attributes.numericAttributes["action-num-" + index] =
+                static_cast<double>(random.below(1000)) / 10.0;
+            attributes.categoricalAttributes["action-cat-" + index] =
+                categoryValue(random.below(5));
+        }
+    }
+    return actions;
+}
+
+}  // namespace bench
+}  // namespace eppoclient
@@ -0,0 +1,83 @@
+#ifndef CONFIG_GENERATOR_HPP
+#define CONFIG_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include "../src/evalbandits.hpp"
+#include "../src/rules.hpp"
+
+namespace eppoclient {
+namespace bench {
+
+// Relative weights of the kinds of conditions the generator emits
+struct ConditionMix {
+    double oneOf = 4.0;    // ONE_OF / NOT_ONE_OF over a string attribute
+    double numeric = 3.0;  // GT / GTE / LT / LTE over a numeric attribute
+    double semVer = 1.0;   // GT / GTE / LT / LTE over a version attribute
+    double regex = 1.0;    // MATCHES / NOT_MATCHES over a string attribute
+    double isNull = 1.0;   // IS_NULL over any attribute
+};
+
+/**
+ * Options of a generated configuration
+ *
+ * Allocation counts and ONE_OF list sizes are drawn from [min, max] with a
+ * geometric skew, as in production configurations: most flags have a few
+ * allocations and short lists, a few reach the maximum.
+ */
+struct ConfigGeneratorOptions {
+    uint64_t seed = 1;
+
+    size_t flagCount = 100;
+    size_t variationsPerFlag = 3;
+    size_t minAllocations = 1;
+    size_t maxAllocations = 10;
+    size_t rulesPerAllocation = 2;
+    size_t conditionsPerRule = 2;
+    ConditionMix conditionMix;
+    size_t minListSize = 1;
+    size_t maxListSize = 100;
+
+    // Distinct subject attributes referenced by conditions, split evenly between
+    // string, numeric and version attributes
+    size_t attributeCount = 30;
+
+    // Bandits, each with a flag "bandit-flag-<i>" whose only variation is the bandit
+    size_t banditCount = 0;
+    size_t actionsPerBandit = 10;
+    size_t attributesPerAction = 4;  // Coefficients per attribute group of an action
+};
+
+/**
+ * Generate a UFC flag configuration response.
+ *
+ * Flags are named "flag-<i>". Every allocation but the last of a flag has
+ * rules; the last one splits every subject across the flag's variations. The
+ * output depends only on the options: the generator uses its own PRNG rather
+ * than the standard library distributions, whose results vary by platform.
+ */
+nlohmann::json generateFlagsJson(const ConfigGeneratorOptions& options);
+
+// Generate the bandit models response for generateFlagsJson()'s bandits
+nlohmann::json generateBanditModelsJson(const ConfigGeneratorOptions& options);
+
+// Generate the attributes of a subject for the generated flags' conditions;
+// a given subject index always yields the same attributes
+Attributes generateSubjectAttributes(const ConfigGeneratorOptions& options,
+                                     uint64_t subjectIndex);
+
+// Generate the subject attributes of a bandit evaluation
+ContextAttributes generateBanditSubjectAttributes(const ConfigGeneratorOptions& options,
+                                                  uint64_t subjectIndex);
+
+// Generate the candidate actions of a bandit evaluation, one per action of the model
+std::map<std::string, ContextAttributes> generateBanditActions(
+    const ConfigGeneratorOptions& options, uint64_t subjectIndex);
+
+}  // namespace bench
+}  // namespace eppoclient
+
+#endif  // CONFIG_GENERATOR_HPP
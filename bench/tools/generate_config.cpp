@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../config_generator.hpp"
+
+/**
+ * Generates a synthetic flag configuration, and optionally bandit models, for
+ * scale benchmarks. The output depends only on the options, so the same
+ * command always writes the same files.
+ *
+ * Usage:
+ *   eppoclient_generate_config [--option=value ...]
+ *
+ * Example: 8,000 flags, up to 50 allocations, ONE_OF lists of up to 10,000 values
+ *   eppoclient_generate_config --flags=8000 --max-allocations=50 --max-list-size=10000
+ */
+
+namespace {
+
+using eppoclient::bench::ConfigGeneratorOptions;
+
+struct SizeOption {
+    const char* name;
+    size_t ConfigGeneratorOptions::*field;
+    const char* description;
+};
+
+const SizeOption kSizeOptions[] = {
+    {"flags", &ConfigGeneratorOptions::flagCount, "Number of flags"},
+    {"variations", &ConfigGeneratorOptions::variationsPerFlag, "Variations per non-boolean flag"},
+    {"min-allocations", &ConfigGeneratorOptions::minAllocations, "Minimum allocations per flag"},
+    {"max-allocations", &ConfigGeneratorOptions::maxAllocations, "Maximum allocations per flag"},
+    {"rules", &ConfigGeneratorOptions::rulesPerAllocation, "Rules per targeted allocation"},
+    {"conditions", &ConfigGeneratorOptions::conditionsPerRule, "Conditions per rule"},
+    {"min-list-size", &ConfigGeneratorOptions::minListSize, "Minimum ONE_OF list size"},
+    {"max-list-size", &ConfigGeneratorOptions::maxListSize, "Maximum ONE_OF list size"},
+    {"attributes", &ConfigGeneratorOptions::attributeCount, "Distinct condition attributes"},
+    {"bandits", &ConfigGeneratorOptions::banditCount, "Number of bandits"},
+    {"actions", &ConfigGeneratorOptions::actionsPerBandit, "Actions per bandit"},
+    {"action-attributes", &ConfigGeneratorOptions::attributesPerAction,
+     "Coefficients per attribute group of an action"},
+};
+
+struct WeightOption {
+    const char* name;
+    double eppoclient::bench::ConditionMix::*field;
+};
+
+const WeightOption kWeightOptions[] = {
+    {"one-of-weight", &eppoclient::bench::ConditionMix::oneOf},
+    {"numeric-weight", &eppoclient::bench::ConditionMix::numeric},
+    {"semver-weight", &eppoclient::bench::ConditionMix::semVer},
+    {"regex-weight", &eppoclient::bench::ConditionMix::regex},
+    {"is-null-weight", &eppoclient::bench::ConditionMix::isNull},
+};
+
+void printUsage(const char* program) {
+    ConfigGeneratorOptions defaults;
+    std::cerr << "Usage: " << program << " [--option=value ...]\n\nOptions:\n";
+    std::cerr << "  --seed=N               PRNG seed (default " << defaults.seed << ")\n";
+    for (const auto& option : kSizeOptions) {
+        std::string flag = std::string("--") + option.name + "=N";
+        flag.resize(std::max<size_t>(flag.size(), 23), ' ');
+        std::cerr << "  " << flag << option.description << " (default "
+                  << defaults.*option.field << ")\n";
+    }
+    for (const auto& option : kWeightOptions) {
+        std::string flag = std::string("--") + option.name + "=W";
+        flag.resize(std::max<size_t>(flag.size(), 23), ' ');
+        std::cerr << "  " << flag << "Relative weight of the condition kind (default "
+                  << defaults.conditionMix.*option.field << ")\n";
+    }
+    std::cerr << "  --flags-out=PATH       Flag configuration output (default flags.json)\n"
+              << "  --bandits-out=PATH     Bandit models output, written when --bandits > 0\n"
+              << "                         (default bandit-models.json)\n";
+}
+
+bool parseSize(const char* text, size_t& value) {
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-') {
+        return false;
+    }
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+bool parseWeight(const char* text, double& value) {
+    char* end = nullptr;
+    double parsed = std::strtod(text, &end);
+    if (end == text || *end != '\0' || parsed < 0) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+// Set the option named by a "--name=value" argument; false if it is invalid
+bool parseArgument(const std::string& argument, ConfigGeneratorOptions& options,
+                   std::string& flagsPath, std::string& banditsPath) {
+    size_t equals = argument.find('=');
+    if (argument.compare(0, 2, "--") != 0 || equals == std::string::npos) {
+        return false;
+    }
+    std::string name = argument.substr(2, equals - 2);
+    const char* value = argument.c_str() + equals + 1;
+
+    if (name == "flags-out") {
+        flagsPath = value;
+        return !flagsPath.empty();
+    }
+    if (name == "bandits-out") {
+        banditsPath = value;
+        return !banditsPath.empty();
+    }
+    if (name == "seed") {
+        size_t seed = 0;
+        if (!parseSize(value, seed)) {
+            return false;
+        }
+        options.seed = seed;
+        return true;
+    }
+    for (const auto& option : kSizeOptions) {
+        if (name == option.name) {
+            return parseSize(value, options.*option.field);
+        }
+    }
+    for (const auto& option : kWeightOptions) {
+        if (name == option.name) {
+            return parseWeight(value, options.conditionMix.*option.field);
+        }
+    }
+    return false;
+}
+
+bool writeJson(const std::string& path, const nlohmann::json& json) {
+    std::ofstream file(path);
+    file << json.dump() << '\n';
+    file.close();
+    if (!file) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << path << std::endl;
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    ConfigGeneratorOptions options;
+    std::string flagsPath = "flags.json";
+    std::string banditsPath = "bandit-models.json";
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (!parseArgument(argv[i], options, flagsPath, banditsPath)) {
+            std::cerr << "Invalid argument: " << argv[i] << "\n\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.minAllocations > options.maxAllocations ||
+        options.minListSize > options.maxListSize) {
+        std::cerr << "Minimum sizes must not exceed maximum sizes" << std::endl;
+        return 1;
+    }
+
+    if (!writeJson(flagsPath, eppoclient::bench::generateFlagsJson(options))) {
+        return 1;
+    }
+    if (options.banditCount > 0 &&
+        !writeJson(banditsPath, eppoclient::bench::generateBanditModelsJson(options))) {
+        return 1;
+    }
+    return 0;
+}
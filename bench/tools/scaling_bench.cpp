@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../src/client.hpp"
+#include "../../src/configuration.hpp"
+#include "../../src/configuration_store.hpp"
+#include "../config_generator.hpp"
+
+/**
+ * Measures how EppoClient evaluation scales with threads.
+ *
+ * For each thread count from 1 to --max-threads (doubling), worker threads run
+ * a mix of flag assignments and bandit actions against one shared EppoClient,
+ * with shared loggers, while another thread keeps replacing the configuration
+ * with ConfigurationStore::setConfiguration(). Each run reports:
+ * - throughput, in total and per thread
+ * - efficiency: per-thread throughput relative to the single-threaded run;
+ *   a drop as threads are added shows contention
+ * - p50, p99 and p99.9 latency of the evaluations
+ * - p99 latency of ConfigurationStore::getConfiguration(), the load every
+ *   evaluation starts with, which contends with configuration swaps
+ *
+ * Usage:
+ *   eppoclient_scaling_bench [--option=value ...]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t durationMs = 1000;      // Per thread count
+    size_t flagCount = 1000;       // Flags of the generated configuration
+    size_t banditPercent = 10;     // Share of evaluations that are bandit actions
+    size_t swapIntervalUs = 1000;  // 0 disables configuration swaps
+    size_t seed = 1;
+};
+
+struct SizeOption {
+    const char* name;
+    size_t Options::*field;
+    const char* description;
+};
+
+const SizeOption kOptions[] = {
+    {"max-threads", &Options::maxThreads, "Largest number of evaluation threads"},
+    {"duration-ms", &Options::durationMs, "Duration of the run for each thread count"},
+    {"flags", &Options::flagCount, "Flags in the generated configuration"},
+    {"bandit-percent", &Options::banditPercent, "Percentage of evaluations that are bandits"},
+    {"swap-interval-us", &Options::swapIntervalUs, "Interval between configuration swaps"},
+    {"seed", &Options::seed, "Seed of the generated configuration"},
+};
+
+void printUsage(const char* program) {
+    Options defaults;
+    std::cerr << "Usage: " << program << " [--option=value ...]\n\nOptions:\n";
+    for (const auto& option : kOptions) {
+        std::string flag = std::string("--") + option.name + "=N";
+        flag.resize(std::max<size_t>(flag.size(), 22), ' ');
+        std::cerr << "  " << flag << option.description << " (default "
+                  << defaults.*option.field << ")\n";
+    }
+}
+
+bool parseArgument(const char* argument, Options& options) {
+    const char* equals = std::strchr(argument, '=');
+    if (std::strncmp(argument, "--", 2) != 0 || equals == nullptr) {
+        return false;
+    }
+    std::string name(argument + 2, equals);
+    for (const auto& option : kOptions) {
+        if (name == option.name) {
+            char* end = nullptr;
+            unsigned long long value = std::strtoull(equals + 1, &end, 10);
+            if (end == equals + 1 || *end != '\0' || equals[1] == '-') {
+                return false;
+            }
+            options.*option.field = static_cast<size_t>(value);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Loggers that only count events, as cheap as a shared logger can be
+class CountingAssignmentLogger : public eppoclient::AssignmentLogger {
+public:
+    std::atomic<uint64_t> count{0};
+
+    void logAssignment(const eppoclient::AssignmentEvent&) override {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+class CountingBanditLogger : public eppoclient::BanditLogger {
+public:
+    std::atomic<uint64_t> count{0};
+
+    void logBanditAction(const eppoclient::BanditEvent&) override {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// Flags, subjects and bandit actions evaluated by the workers
+struct Workload {
+    struct Flag {
+        std::string key;
+        eppoclient::VariationType variationType;
+    };
+
+    std::vector<Flag> flags;
+    std::vector<std::string> subjectKeys;
+    std::vector<eppoclient::Attributes> subjectAttributes;
+    std::vector<eppoclient::ContextAttributes> banditSubjectAttributes;
+    std::vector<std::map<std::string, eppoclient::ContextAttributes>> banditActions;
+};
+
+struct ThreadResult {
+    uint64_t evaluations = 0;
+    std::vector<uint64_t> latencies;      // Nanoseconds per evaluation
+    std::vector<uint64_t> loadLatencies;  // Nanoseconds per sampled configuration load
+};
+
+struct RunResult {
+    size_t threads = 0;
+    uint64_t evaluations = 0;
+    uint64_t swaps = 0;
+    double seconds = 0;
+    std::vector<uint64_t> latencies;
+    std::vector<uint64_t> loadLatencies;
+};
+
+void evaluate(eppoclient::EppoClient& client, const Workload& workload, uint64_t operation,
+              size_t thread, size_t banditPercent) {
+    size_t subject = (operation + thread * 7) % workload.subjectKeys.size();
+    const std::string& subjectKey = workload.subjectKeys[subject];
+
+    if (operation % 100 < banditPercent) {
+        client.getBanditAction("bandit-flag-0", subjectKey,
+                               workload.banditSubjectAttributes[subject],
+                               workload.banditActions[subject], "default");
+        return;
+    }
+
+    const Workload::Flag& flag = workload.flags[(operation * 31 + thread) % workload.flags.size()];
+    const eppoclient::Attributes& attributes = workload.subjectAttributes[subject];
+    switch (flag.variationType) {
+        case eppoclient::VariationType::BOOLEAN:
+            client.getBooleanAssignment(flag.key, subjectKey, attributes, false);
+            break;
+        case eppoclient::VariationType::INTEGER:
+            client.getIntegerAssignment(flag.key, subjectKey, attributes, 0);
+            break;
+        case eppoclient::VariationType::NUMERIC:
+            client.getNumericAssignment(flag.key, subjectKey, attributes, 0.0);
+            break;
+        case eppoclient::VariationType::JSON:
+            client.getJSONAssignment(flag.key, subjectKey, attributes, nlohmann::json());
+            break;
+        case eppoclient::VariationType::STRING:
+        default:
+            client.getStringAssignment(flag.key, subjectKey, attributes, "default");
+            break;
+    }
+}
+
+RunResult run(size_t threadCount, const Options& options, const Workload& workload,
+              const std::shared_ptr<eppoclient::ConfigurationStore>& store,
+              eppoclient::EppoClient& client,
+              const std::vector<std::shared_ptr<const eppoclient::Configuration>>& configurations) {
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::vector<ThreadResult> results(threadCount);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            ThreadResult& result = results[t];
+            result.latencies.reserve(1 << 20);
+            while (!started.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint64_t operation = 0; !stopped.load(std::memory_order_relaxed); ++operation) {
+                Clock::time_point start = Clock::now();
+                evaluate(client, workload, operation, t, options.banditPercent);
+                Clock::time_point end = Clock::now();
+                result.latencies.push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+
+                // Sample the configuration load on its own
+                if (operation % 16 == 0) {
+                    start = Clock::now();
+                    auto configuration = store->getConfiguration();
+                    end = Clock::now();
+                    result.loadLatencies.push_back(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                            .count()));
+                }
+                ++result.evaluations;
+            }
+        });
+    }
+
+    std::atomic<uint64_t> swaps{0};
+    std::thread swapper;
+    if (options.swapIntervalUs > 0) {
+        swapper = std::thread([&]() {
+            while (!started.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (!stopped.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(options.swapIntervalUs));
+                store->setConfiguration(configurations[swaps % configurations.size()]);
+                swaps.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    started.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.durationMs));
+    stopped.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    Clock::time_point end = Clock::now();
+    if (swapper.joinable()) {
+        swapper.join();
+    }
+
+    RunResult summary;
+    summary.threads = threadCount;
+    summary.swaps = swaps;
+    summary.seconds = std::chrono::duration<double>(end - start).count();
+    for (auto& result : results) {
+        summary.evaluations += result.evaluations;
+        summary.latencies.insert(summary.latencies.end(), result.latencies.begin(),
+                                 result.latencies.end());
+        summary.loadLatencies.insert(summary.loadLatencies.end(), result.loadLatencies.begin(),
+                                     result.loadLatencies.end());
+    }
+    std::sort(summary.latencies.begin(), summary.latencies.end());
+    std::sort(summary.loadLatencies.begin(), summary.loadLatencies.end());
+    return summary;
+}
+
+// Percentile of sorted nanosecond latencies, in microseconds
+double percentileUs(const std::vector<uint64_t>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()));
+    return static_cast<double>(sorted[index]) / 1000.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (!parseArgument(argv[i], options)) {
+            std::cerr << "Invalid argument: " << argv[i] << "\n\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.maxThreads == 0 || options.flagCount == 0 || options.banditPercent > 100) {
+        std::cerr << "--max-threads and --flags must be positive, --bandit-percent at most 100"
+                  << std::endl;
+        return 1;
+    }
+
+    eppoclient::bench::ConfigGeneratorOptions generatorOptions;
+    generatorOptions.seed = options.seed;
+    generatorOptions.flagCount = options.flagCount;
+    generatorOptions.banditCount = 1;
+    generatorOptions.actionsPerBandit = 20;
+    std::string flagsJson = eppoclient::bench::generateFlagsJson(generatorOptions).dump();
+    std::string banditsJson = eppoclient::bench::generateBanditModelsJson(generatorOptions).dump();
+
+    // Swaps alternate between two snapshots of the same configuration, as when
+    // a poller receives an unchanged configuration
+    std::vector<std::shared_ptr<const eppoclient::Configuration>> configurations;
+    for (int i = 0; i < 2; ++i) {
+        auto result = eppoclient::parseConfiguration(flagsJson, banditsJson);
+        if (!result.hasValue()) {
+            std::cerr << "Failed to parse the generated configuration" << std::endl;
+            return 1;
+        }
+        configurations.push_back(
+            std::make_shared<const eppoclient::Configuration>(std::move(*result.value)));
+    }
+
+    Workload workload;
+    for (size_t i = 0; i < options.flagCount; ++i) {
+        std::string key = "flag-" + std::to_string(i);
+        const auto* flag = configurations[0]->getFlagConfiguration(key);
+        if (flag != nullptr) {
+            workload.flags.push_back({key, flag->variationType});
+        }
+    }
+    for (uint64_t i = 0; i < 256; ++i) {
+        workload.subjectKeys.push_back("subject-" + std::to_string(i));
+        workload.subjectAttributes.push_back(
+            eppoclient::bench::generateSubjectAttributes(generatorOptions, i));
+        workload.banditSubjectAttributes.push_back(
+            eppoclient::bench::generateBanditSubjectAttributes(generatorOptions, i));
+        workload.banditActions.push_back(
+            eppoclient::bench::generateBanditActions(generatorOptions, i));
+    }
+
+    auto store = std::make_shared<eppoclient::ConfigurationStore>(configurations[0]);
+    auto assignmentLogger = std::make_shared<CountingAssignmentLogger>();
+    auto banditLogger = std::make_shared<CountingBanditLogger>();
+    eppoclient::EppoClient client(store, assignmentLogger, banditLogger);
+
+    std::cout << "Flags: " << workload.flags.size() << ", bandit evaluations: "
+              << options.banditPercent << "%, configuration swap interval: "
+              << options.swapIntervalUs << " us, hardware threads: "
+              << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "evals/s" << std::setw(16)
+              << "evals/s/thread" << std::setw(12) << "efficiency" << std::setw(10) << "p50 us"
+              << std::setw(10) << "p99 us" << std::setw(11) << "p99.9 us" << std::setw(14)
+              << "load p99 us" << std::setw(9) << "swaps" << "\n";
+
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < options.maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(options.maxThreads);
+
+    double singleThreadRate = 0.0;
+    for (size_t threads : threadCounts) {
+        RunResult result = run(threads, options, workload, store, client, configurations);
+        double rate = static_cast<double>(result.evaluations) / result.seconds;
+        double perThread = rate / static_cast<double>(threads);
+        if (singleThreadRate == 0.0) {
+            singleThreadRate = perThread;
+        }
+        std::cout << std::fixed << std::setprecision(0) << std::setw(8) << threads
+                  << std::setw(14) << rate << std::setw(16) << perThread << std::setprecision(2)
+                  << std::setw(12) << perThread / singleThreadRate << std::setw(10)
+                  << percentileUs(result.latencies, 0.50) << std::setw(10)
+                  << percentileUs(result.latencies, 0.99) << std::setw(11)
+                  << percentileUs(result.latencies, 0.999) << std::setw(14)
+                  << percentileUs(result.loadLatencies, 0.99) << std::setw(9) << result.swaps
+                  << std::endl;
+    }
+
+    std::cout << "\nAssignment events: " << assignmentLogger->count
+              << ", bandit events: " << banditLogger->count << std::endl;
+    return 0;
+}
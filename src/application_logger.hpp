@@ -2,9 +2,13 @@
 #define APPLICATION_LOGGER_HPP
 
 #include <string>
+#include <utility>
 
 namespace eppoclient {
 
+// Severity of an application log message
+enum class LogLevel { Debug, Info, Warn, Error };
+
 // Application logger interface for logging
 class ApplicationLogger {
 public:
@@ -13,6 +17,41 @@ public:
     virtual void info(const std::string& message) = 0;
     virtual void warn(const std::string& message) = 0;
     virtual void error(const std::string& message) = 0;
+
+    // Whether messages of the given level are logged. The SDK does not build
+    // messages of disabled levels; override to skip levels cheaply.
+    virtual bool isEnabled(LogLevel) const { return true; }
+
+    /**
+     * Log the message returned by buildMessage at the given level. buildMessage is
+     * only called if the level is enabled, so messages that are discarded cost no
+     * string construction.
+     *
+     * @code
+     * logger.log(LogLevel::Info, [&] { return "Failed to get flag configuration for: " + key; });
+     * @endcode
+     */
+    template <typename MessageBuilder>
+    void log(LogLevel level, MessageBuilder&& buildMessage) {
+        if (!isEnabled(level)) {
+            return;
+        }
+        const std::string message = std::forward<MessageBuilder>(buildMessage)();
+        switch (level) {
+            case LogLevel::Debug:
+                debug(message);
+                break;
+            case LogLevel::Info:
+                info(message);
+                break;
+            case LogLevel::Warn:
+                warn(message);
+                break;
+            case LogLevel::Error:
+                error(message);
+                break;
+        }
+    }
 };
 
 // No-op implementation of ApplicationLogger
@@ -23,6 +62,7 @@ public:
     void info(const std::string&) override {}
     void warn(const std::string&) override {}
     void error(const std::string&) override {}
+    bool isEnabled(LogLevel) const override { return false; }
 };
 
 }  // namespace eppoclient
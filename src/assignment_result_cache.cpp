@@ -0,0 +1,158 @@
+#include "assignment_result_cache.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace eppoclient {
+
+namespace {
+
+constexpr size_t kMaxShards = 16;
+
+// Finalizer from MurmurHash3, spreading every input bit over the whole hash
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t hashString(std::string_view s) {
+    return static_cast<uint64_t>(std::hash<std::string_view>{}(s));
+}
+
+uint64_t hashAttributeValue(const AttributeValue& value) {
+    uint64_t h = 0;
+    if (const auto* s = std::get_if<std::string>(&value)) {
+        h = hashString(*s);
+    } else if (const auto* i = std::get_if<int64_t>(&value)) {
+        h = static_cast<uint64_t>(*i);
+    } else if (const auto* d = std::get_if<double>(&value)) {
+        h = static_cast<uint64_t>(std::hash<double>{}(*d));
+    } else if (const auto* b = std::get_if<bool>(&value)) {
+        h = *b ? 1 : 0;
+    }
+    return mix(h ^ value.index());
+}
+
+// Hash the lookup key; attributes are combined with addition so the hash does
+// not depend on the iteration order of the attribute map
+uint64_t hashKey(const Configuration* configuration, std::string_view flagKey,
+                 std::string_view subjectKey, const Attributes& subjectAttributes,
+                 VariationType variationType) {
+    uint64_t attributesHash = 0;
+    for (const auto& [name, value] : subjectAttributes) {
+        attributesHash += mix(hashString(name) ^ hashAttributeValue(value));
+    }
+
+    uint64_t h = mix(hashString(flagKey) ^ static_cast<uint64_t>(variationType));
+    h = mix(h ^ hashString(subjectKey));
+    h = mix(h ^ reinterpret_cast<uintptr_t>(configuration));
+    return mix(h ^ attributesHash);
+}
+
+// Whether an entry was evaluated against a configuration snapshot. Owners are
+// compared rather than addresses, so a new snapshot allocated at the address of
+// an expired one does not match its entries.
+bool isSameSnapshot(const std::weak_ptr<const Configuration>& entryConfiguration,
+                    const std::shared_ptr<const Configuration>& configuration) {
+    return !entryConfiguration.owner_before(configuration) &&
+           !configuration.owner_before(entryConfiguration);
+}
+
+// Time at which a time-bounded allocation of the flag next starts or ends, after
+// which the flag may evaluate differently; std::nullopt if there is none
+std::optional<std::chrono::system_clock::time_point> nextAllocationBoundary(
+    const FlagConfiguration& flag, std::chrono::system_clock::time_point now) {
+    std::optional<std::chrono::system_clock::time_point> boundary;
+    auto consider = [&](const std::optional<std::chrono::system_clock::time_point>& time) {
+        if (time.has_value() && *time >= now && (!boundary.has_value() || *time < *boundary)) {
+            boundary = *time;
+        }
+    };
+    for (const auto& allocation : flag.allocations) {
+        consider(allocation.startAt);
+        consider(allocation.endAt);
+    }
+    return boundary;
+}
+
+}  // namespace
+
+AssignmentResultCache::AssignmentResultCache(size_t capacity) {
+    assert(capacity > 0 && "cache capacity must be positive");
+
+    size_t shardCount = std::min(capacity, kMaxShards);
+    size_t shardCapacity = (capacity + shardCount - 1) / shardCount;
+    shards_.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>(shardCapacity));
+    }
+}
+
+std::shared_ptr<const EvalResult> AssignmentResultCache::get(
+    const std::shared_ptr<const Configuration>& configuration, std::string_view flagKey,
+    std::string_view subjectKey, const Attributes& subjectAttributes,
+    VariationType variationType) {
+    uint64_t hash =
+        hashKey(configuration.get(), flagKey, subjectKey, subjectAttributes, variationType);
+    Shard& shard = shardFor(hash);
+
+    std::shared_ptr<const Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto [cached, found] = shard.entries.Get(hash);
+        if (!found) {
+            return nullptr;
+        }
+        entry = std::move(cached);
+    }
+
+    // Compare the full key outside the lock
+    if (entry->variationType != variationType || entry->flagKey != flagKey ||
+        entry->subjectKey != subjectKey || entry->subjectAttributes != subjectAttributes ||
+        !isSameSnapshot(entry->configuration, configuration)) {
+        return nullptr;
+    }
+    if (entry->expiresAt.has_value() && std::chrono::system_clock::now() >= *entry->expiresAt) {
+        return nullptr;
+    }
+
+    return std::shared_ptr<const EvalResult>(entry, &entry->result);
+}
+
+void AssignmentResultCache::put(const std::shared_ptr<const Configuration>& configuration,
+                                const FlagConfiguration& flag, std::string_view flagKey,
+                                std::string_view subjectKey, const Attributes& subjectAttributes,
+                                VariationType variationType, const EvalResult& result) {
+    auto entry = std::make_shared<Entry>();
+    entry->configuration = configuration;
+    entry->flagKey = std::string(flagKey);
+    entry->subjectKey = std::string(subjectKey);
+    entry->subjectAttributes = subjectAttributes;
+    entry->variationType = variationType;
+    entry->expiresAt = nextAllocationBoundary(flag, std::chrono::system_clock::now());
+    entry->result = result;
+
+    uint64_t hash =
+        hashKey(configuration.get(), flagKey, subjectKey, subjectAttributes, variationType);
+    Shard& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.Add(hash, std::shared_ptr<const Entry>(std::move(entry)));
+}
+
+size_t AssignmentResultCache::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->entries.Len();
+    }
+    return total;
+}
+
+}  // namespace eppoclient
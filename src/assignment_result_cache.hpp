@@ -0,0 +1,94 @@
+#ifndef ASSIGNMENT_RESULT_CACHE_HPP
+#define ASSIGNMENT_RESULT_CACHE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "config_response.hpp"
+#include "configuration.hpp"
+#include "evalflags.hpp"
+#include "lru2q.hpp"
+#include "rules.hpp"
+
+namespace eppoclient {
+
+/**
+ * AssignmentResultCache - a bounded, thread-safe cache of flag evaluation results
+ *
+ * Results are keyed by flag key, subject key, subject attributes, the expected
+ * variation type and the configuration snapshot they were evaluated against.
+ * Entries are located by a hash of the key and then compared in full, so a hash
+ * collision is a cache miss, never a wrong result.
+ *
+ * Since the snapshot is part of the key, results of a replaced configuration are
+ * never returned for the current one, and evaluations pinned to an older snapshot
+ * (e.g. by an EvaluationSession) are cached next to those of the current one
+ * without invalidating them. Entries only refer to their snapshot weakly, so they
+ * do not keep a replaced configuration alive; they are evicted as new results are
+ * stored.
+ *
+ * The cache is split into independently locked shards, each holding a 2Q cache.
+ *
+ * The result's assignment event is stored with it and shared by every hit, so
+ * callers can log it again without copying it.
+ *
+ * Results of flags with time-bounded allocations expire at the next allocation
+ * start or end time.
+ */
+class AssignmentResultCache {
+public:
+    // Create a cache holding up to capacity results (must be positive)
+    explicit AssignmentResultCache(size_t capacity);
+
+    AssignmentResultCache(const AssignmentResultCache&) = delete;
+    AssignmentResultCache& operator=(const AssignmentResultCache&) = delete;
+
+    /**
+     * Get the cached result of evaluating a flag for a subject.
+     * Returns nullptr if the result is not cached for this configuration snapshot.
+     */
+    std::shared_ptr<const EvalResult> get(const std::shared_ptr<const Configuration>& configuration,
+                                          std::string_view flagKey, std::string_view subjectKey,
+                                          const Attributes& subjectAttributes,
+                                          VariationType variationType);
+
+    // Store the result of evaluating a flag for a subject
+    void put(const std::shared_ptr<const Configuration>& configuration,
+             const FlagConfiguration& flag, std::string_view flagKey, std::string_view subjectKey,
+             const Attributes& subjectAttributes, VariationType variationType,
+             const EvalResult& result);
+
+    // Get the number of cached results
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::weak_ptr<const Configuration> configuration;
+        std::string flagKey;
+        std::string subjectKey;
+        Attributes subjectAttributes;
+        VariationType variationType;
+        std::optional<std::chrono::system_clock::time_point> expiresAt;
+        EvalResult result;
+    };
+
+    struct Shard {
+        explicit Shard(size_t capacity) : entries(capacity) {}
+
+        mutable std::mutex mutex;
+        cache::TwoQueueCache<uint64_t, std::shared_ptr<const Entry>> entries;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    Shard& shardFor(uint64_t hash) { return *shards_[(hash >> 32) % shards_.size()]; }
+};
+
+}  // namespace eppoclient
+
+#endif  // ASSIGNMENT_RESULT_CACHE_HPP
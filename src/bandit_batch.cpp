@@ -0,0 +1,110 @@
+#include "bandit_batch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "time_utils.hpp"
+
+namespace eppoclient {
+
+namespace {
+
+// Contexts a worker claims at a time: enough to keep contention on the shared
+// counter low, few enough to balance action sets of uneven sizes
+constexpr size_t kBatchChunkSize = 64;
+
+template <typename Context>
+void evaluateBatch(const BanditConfiguration& bandit, const Context* contexts, size_t count,
+                   BanditEvaluationDetails* results, std::optional<BanditEvent>* events,
+                   std::vector<internal::BanditScratch>& scratches) {
+    if (count == 0) {
+        return;
+    }
+    const std::string timestamp =
+        events != nullptr ? formatISOTimestamp(std::chrono::system_clock::now()) : std::string();
+
+    // Each worker reuses its own scratch state for every context it claims
+    std::atomic<size_t> nextContext{0};
+    auto work = [&](internal::BanditScratch& scratch) {
+        for (size_t begin = nextContext.fetch_add(kBatchChunkSize); begin < count;
+             begin = nextContext.fetch_add(kBatchChunkSize)) {
+            size_t end = std::min(count, begin + kBatchChunkSize);
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = internal::evaluateBandit(bandit.modelData, contexts[i], scratch);
+                if (events == nullptr) {
+                    continue;
+                }
+                if (contexts[i].actions.empty()) {
+                    events[i] = std::nullopt;
+                } else {
+                    events[i] = createBanditEvent(results[i].flagKey, results[i].subjectKey,
+                                                  bandit.banditKey, bandit.modelVersion,
+                                                  results[i], timestamp);
+                }
+            }
+        }
+    };
+
+    size_t chunkCount = (count + kBatchChunkSize - 1) / kBatchChunkSize;
+    size_t workerCount = std::min(scratches.size(), chunkCount);
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    for (size_t i = 1; i < workerCount; ++i) {
+        threads.emplace_back(work, std::ref(scratches[i]));
+    }
+    work(scratches[0]);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace
+
+BanditBatchEvaluator::BanditBatchEvaluator(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    scratches_.resize(threadCount);
+}
+
+void BanditBatchEvaluator::evaluate(const BanditConfiguration& bandit,
+                                    const BanditEvaluationContext* contexts, size_t count,
+                                    BanditEvaluationDetails* results,
+                                    std::optional<BanditEvent>* events) {
+    evaluateBatch(bandit, contexts, count, results, events, scratches_);
+}
+
+void BanditBatchEvaluator::evaluate(const BanditConfiguration& bandit,
+                                    const BanditColumnarEvaluationContext* contexts,
+                                    size_t count, BanditEvaluationDetails* results,
+                                    std::optional<BanditEvent>* events) {
+    evaluateBatch(bandit, contexts, count, results, events, scratches_);
+}
+
+size_t BanditBatchEvaluator::getScratchCapacity() const {
+    size_t capacity = 0;
+    for (const auto& scratch : scratches_) {
+        capacity += scratch.capacity();
+    }
+    return capacity;
+}
+
+void evaluateBanditBatch(const BanditConfiguration& bandit,
+                         const BanditEvaluationContext* contexts, size_t count,
+                         BanditEvaluationDetails* results, std::optional<BanditEvent>* events,
+                         size_t threadCount) {
+    BanditBatchEvaluator(threadCount).evaluate(bandit, contexts, count, results, events);
+}
+
+void evaluateBanditBatch(const BanditConfiguration& bandit,
+                         const BanditColumnarEvaluationContext* contexts, size_t count,
+                         BanditEvaluationDetails* results, std::optional<BanditEvent>* events,
+                         size_t threadCount) {
+    BanditBatchEvaluator(threadCount).evaluate(bandit, contexts, count, results, events);
+}
+
+}  // namespace eppoclient
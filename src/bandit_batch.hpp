@@ -0,0 +1,105 @@
+#ifndef BANDIT_BATCH_HPP
+#define BANDIT_BATCH_HPP
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "bandit_model.hpp"
+#include "evalbandits.hpp"
+
+namespace eppoclient {
+
+/**
+ * Evaluates a bandit for many contexts at once, such as when replaying logged
+ * contexts for offline policy evaluation.
+ *
+ * Every context is evaluated against the given bandit configuration, so the whole
+ * batch sees one model; keep the Configuration it belongs to alive for the call.
+ * Contexts are shared out in chunks among worker threads, the calling thread
+ * included, and each worker reuses its evaluation scratch state across the
+ * contexts it evaluates. The scratch state is freed when the call returns; use a
+ * BanditBatchEvaluator to also reuse it across batches.
+ *
+ * results[i] receives what evaluateBandit() returns for contexts[i]. If events is
+ * not nullptr, events[i] receives the BanditEvent to log for contexts[i], or
+ * std::nullopt if the context has no actions; all events are timestamped with the
+ * start of the batch. Output arrays must hold count elements.
+ *
+ * @param threadCount Number of threads to evaluate on, including the calling
+ *                    thread; 0 to use one per hardware thread
+ *
+ * Example usage:
+ * @code
+ * const eppoclient::BanditConfiguration* bandit = config->getBanditConfiguration("my-bandit");
+ *
+ * std::vector<eppoclient::BanditEvaluationContext> contexts;
+ * for (const auto& record : replayLog) {
+ *     contexts.emplace_back("my-flag", record.subjectKey, record.subjectAttributes,
+ *                           record.actions);
+ * }
+ * std::vector<eppoclient::BanditEvaluationDetails> results(contexts.size());
+ * eppoclient::evaluateBanditBatch(*bandit, contexts.data(), contexts.size(), results.data());
+ * @endcode
+ */
+void evaluateBanditBatch(const BanditConfiguration& bandit,
+                         const BanditEvaluationContext* contexts, size_t count,
+                         BanditEvaluationDetails* results,
+                         std::optional<BanditEvent>* events = nullptr, size_t threadCount = 0);
+
+/**
+ * Evaluates a bandit for many contexts with columnar action tables.
+ * Behaves like evaluateBanditBatch() over BanditEvaluationContexts.
+ */
+void evaluateBanditBatch(const BanditConfiguration& bandit,
+                         const BanditColumnarEvaluationContext* contexts, size_t count,
+                         BanditEvaluationDetails* results,
+                         std::optional<BanditEvent>* events = nullptr, size_t threadCount = 0);
+
+/**
+ * BanditBatchEvaluator - evaluates bandit batches, reusing its workers' evaluation
+ * scratch state from batch to batch
+ *
+ * Each batch is evaluated like evaluateBanditBatch() on the evaluator's thread
+ * count. Worker threads are started per batch, but their scratch state is owned
+ * by the evaluator, so repeated batches of similar sizes do not allocate it again.
+ *
+ * An evaluator must not evaluate multiple batches at once.
+ *
+ * Example usage:
+ * @code
+ * eppoclient::BanditBatchEvaluator evaluator;
+ * for (const auto& replayChunk : replayChunks) {
+ *     evaluator.evaluate(*bandit, replayChunk.contexts.data(), replayChunk.contexts.size(),
+ *                        replayChunk.results.data());
+ * }
+ * @endcode
+ */
+class BanditBatchEvaluator {
+public:
+    // Evaluate on threadCount threads, including the calling thread; 0 to use one
+    // per hardware thread
+    explicit BanditBatchEvaluator(size_t threadCount = 0);
+
+    // Evaluate a batch of contexts; see evaluateBanditBatch()
+    void evaluate(const BanditConfiguration& bandit, const BanditEvaluationContext* contexts,
+                  size_t count, BanditEvaluationDetails* results,
+                  std::optional<BanditEvent>* events = nullptr);
+
+    // Evaluate a batch of contexts with columnar action tables
+    void evaluate(const BanditConfiguration& bandit,
+                  const BanditColumnarEvaluationContext* contexts, size_t count,
+                  BanditEvaluationDetails* results, std::optional<BanditEvent>* events = nullptr);
+
+    size_t getThreadCount() const { return scratches_.size(); }
+
+    // Number of actions per context the workers can evaluate without allocating,
+    // summed over workers
+    size_t getScratchCapacity() const;
+
+private:
+    std::vector<internal::BanditScratch> scratches_;  // One per worker
+};
+
+}  // namespace eppoclient
+
+#endif  // BANDIT_BATCH_HPP
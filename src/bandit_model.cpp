@@ -1,4 +1,6 @@
 #include "bandit_model.hpp"
+#include <algorithm>
+#include <utility>
 #include "json_utils.hpp"
 #include "time_utils.hpp"
 
@@ -202,6 +204,118 @@ std::optional<BanditVariation> parseBanditVariation(const nlohmann::json& j, std
 
 }  // namespace internal
 
+namespace {
+
+// Intern an attribute name, returning its dense ID
+uint32_t internAttribute(CompiledBanditModel::AttributeTable& table, const std::string& name) {
+    auto [it, inserted] = table.ids.emplace(name, static_cast<uint32_t>(table.valueIds.size()));
+    if (inserted) {
+        table.valueIds.emplace_back();
+    }
+    return it->second;
+}
+
+void compileNumericTerms(const std::vector<BanditNumericAttributeCoefficient>& coefficients,
+                         CompiledBanditModel::AttributeTable& table,
+                         CompiledBanditModel::NumericTerms& terms) {
+    for (const auto& coefficient : coefficients) {
+        terms.attributeIds.push_back(internAttribute(table, coefficient.attributeKey));
+        terms.coefficients.push_back(coefficient.coefficient);
+        terms.missingValueCoefficients.push_back(coefficient.missingValueCoefficient);
+    }
+}
+
+// Build the sorted value table of each categorical coefficient, interning its
+// attribute and values
+void compileCategoricalTerms(
+    const std::vector<BanditCategoricalAttributeCoefficient>& coefficients,
+    CompiledBanditModel::AttributeTable& table, CompiledBanditModel::CategoricalTerms& terms) {
+    std::vector<std::pair<uint32_t, double>> entries;
+    for (const auto& coefficient : coefficients) {
+        uint32_t attributeId = internAttribute(table, coefficient.attributeKey);
+        auto& valueIds = table.valueIds[attributeId];
+
+        entries.clear();
+        for (const auto& [value, score] : coefficient.valueCoefficients) {
+            auto [it, _] = valueIds.emplace(value, static_cast<uint32_t>(valueIds.size()));
+            entries.emplace_back(it->second, score);
+        }
+        std::sort(entries.begin(), entries.end());
+
+        terms.attributeIds.push_back(attributeId);
+        terms.missingValueCoefficients.push_back(coefficient.missingValueCoefficient);
+        for (const auto& [valueId, score] : entries) {
+            terms.valueIds.push_back(valueId);
+            terms.scores.push_back(score);
+        }
+        terms.offsets.push_back(static_cast<uint32_t>(terms.valueIds.size()));
+    }
+}
+
+// Append the bytes of an array to a key, preceded by its length
+template <typename T>
+void appendBytes(std::string& key, const std::vector<T>& values) {
+    size_t size = values.size();
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(reinterpret_cast<const char*>(values.data()), size * sizeof(T));
+}
+
+// Bitwise key of an action's subject terms, so that only sets whose sums are
+// bit-identical for every subject compare equal
+std::string subjectTermsKey(const CompiledBanditModel::Action& action) {
+    std::string key;
+    appendBytes(key, action.subjectNumeric.attributeIds);
+    appendBytes(key, action.subjectNumeric.coefficients);
+    appendBytes(key, action.subjectNumeric.missingValueCoefficients);
+    appendBytes(key, action.subjectCategorical.attributeIds);
+    appendBytes(key, action.subjectCategorical.offsets);
+    appendBytes(key, action.subjectCategorical.valueIds);
+    appendBytes(key, action.subjectCategorical.scores);
+    appendBytes(key, action.subjectCategorical.missingValueCoefficients);
+    return key;
+}
+
+}  // namespace
+
+void CompiledBanditModel::build(const std::map<std::string, BanditCoefficients>& coefficients) {
+    *this = CompiledBanditModel();
+
+    actions.reserve(coefficients.size());
+    for (const auto& [actionKey, actionCoefficients] : coefficients) {
+        actionIds.emplace(actionKey, static_cast<uint32_t>(actions.size()));
+        Action& action = actions.emplace_back();
+        action.intercept = actionCoefficients.intercept;
+        compileNumericTerms(actionCoefficients.subjectNumericCoefficients, subjectNumericAttributes,
+                            action.subjectNumeric);
+        compileCategoricalTerms(actionCoefficients.subjectCategoricalCoefficients,
+                                subjectCategoricalAttributes, action.subjectCategorical);
+        compileNumericTerms(actionCoefficients.actionNumericCoefficients, actionNumericAttributes,
+                            action.actionNumeric);
+        compileCategoricalTerms(actionCoefficients.actionCategoricalCoefficients,
+                                actionCategoricalAttributes, action.actionCategorical);
+    }
+
+    // Group actions with identical subject terms
+    std::map<std::string, uint32_t> subjectTermsIds;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        actions[i].subjectTermsId =
+            subjectTermsIds.emplace(subjectTermsKey(actions[i]), static_cast<uint32_t>(i))
+                .first->second;
+    }
+
+    valid = true;
+}
+
+void BanditModelData::precompute() {
+    compiledModel.build(coefficients);
+}
+
+void BanditResponse::precompute() {
+    for (auto& [banditKey, bandit] : bandits) {
+        bandit.modelData.precompute();
+    }
+}
+
 // BanditNumericAttributeCoefficient serialization
 void to_json(nlohmann::json& j, const BanditNumericAttributeCoefficient& bnac) {
     j = nlohmann::json{{"attributeKey", bnac.attributeKey},
@@ -1,11 +1,15 @@
 #ifndef BANDIT_MODEL_HPP
 #define BANDIT_MODEL_HPP
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <istream>
 #include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -58,6 +62,80 @@ struct BanditCoefficients {
 
 void to_json(nlohmann::json& j, const BanditCoefficients& bc);
 
+// Compiled bandit coefficients for scoring (not serialized)
+//
+// The attribute names referenced by the coefficients are interned to dense IDs,
+// separately for subject numeric, subject categorical, action numeric and action
+// categorical attributes, and the values named by categorical coefficients to
+// dense value IDs per attribute. A context's attributes are resolved to these IDs
+// once, after which scoring an action is a pass over contiguous arrays indexed by
+// ID instead of a map lookup per coefficient and per categorical value.
+struct CompiledBanditModel {
+    // Attribute names of one kind -> dense attribute IDs
+    struct AttributeTable {
+        std::unordered_map<std::string, uint32_t> ids;
+        // Categorical attributes only: value -> dense value ID, per attribute ID
+        std::vector<std::unordered_map<std::string, uint32_t>> valueIds;
+
+        size_t size() const { return valueIds.size(); }
+    };
+
+    // Numeric coefficients of one kind for an action, in configuration order
+    struct NumericTerms {
+        std::vector<uint32_t> attributeIds;
+        std::vector<double> coefficients;
+        std::vector<double> missingValueCoefficients;
+    };
+
+    // Categorical coefficients of one kind for an action, in configuration order.
+    // Term i holds the value IDs its coefficient names, sorted, in
+    // valueIds[offsets[i]..offsets[i + 1]) and their scores at the same positions
+    // in scores. A context value without an entry there, or a missing attribute,
+    // contributes the term's missing value coefficient.
+    struct CategoricalTerms {
+        std::vector<uint32_t> attributeIds;
+        std::vector<uint32_t> offsets{0};
+        std::vector<uint32_t> valueIds;
+        std::vector<double> scores;
+        std::vector<double> missingValueCoefficients;
+
+        // Score of term i for the value with ID slot
+        double score(size_t i, uint32_t slot) const {
+            auto begin = valueIds.begin() + offsets[i];
+            auto end = valueIds.begin() + offsets[i + 1];
+            auto it = std::lower_bound(begin, end, slot);
+            if (it == end || *it != slot) {
+                return missingValueCoefficients[i];
+            }
+            return scores[static_cast<size_t>(it - valueIds.begin())];
+        }
+    };
+
+    struct Action {
+        double intercept = 0.0;
+        NumericTerms subjectNumeric;
+        CategoricalTerms subjectCategorical;
+        NumericTerms actionNumeric;
+        CategoricalTerms actionCategorical;
+
+        // Index of the first action with the same subject terms as this one;
+        // actions sharing it have the same subject score components
+        uint32_t subjectTermsId = 0;
+    };
+
+    bool valid = false;
+    AttributeTable subjectNumericAttributes;
+    AttributeTable subjectCategoricalAttributes;
+    AttributeTable actionNumericAttributes;
+    AttributeTable actionCategoricalAttributes;
+
+    // Action key -> index into actions
+    std::unordered_map<std::string, uint32_t> actionIds;
+    std::vector<Action> actions;
+
+    void build(const std::map<std::string, BanditCoefficients>& coefficients);
+};
+
 /**
  * Model data for the bandit algorithm.
  * Contains gamma (exploration parameter), default scores, and coefficients for all actions.
@@ -68,7 +146,13 @@ struct BanditModelData {
     double actionProbabilityFloor;
     std::map<std::string, BanditCoefficients> coefficients;
 
+    // Coefficients compiled for scoring (not serialized)
+    CompiledBanditModel compiledModel;
+
     BanditModelData() : gamma(0.0), defaultActionScore(0.0), actionProbabilityFloor(0.0) {}
+
+    // Compile the coefficients for scoring
+    void precompute();
 };
 
 void to_json(nlohmann::json& j, const BanditModelData& bmd);
@@ -94,10 +178,13 @@ void to_json(nlohmann::json& j, const BanditConfiguration& bc);
  * This is the top-level structure returned from the bandit configuration endpoint.
  */
 struct BanditResponse {
-    std::map<std::string, BanditConfiguration> bandits;
+    std::map<std::string, BanditConfiguration, std::less<>> bandits;
     std::chrono::system_clock::time_point updatedAt;
 
     BanditResponse() = default;
+
+    // Compile the models of all bandits for scoring
+    void precompute();
 };
 
 void to_json(nlohmann::json& j, const BanditResponse& br);
@@ -0,0 +1,292 @@
+#include "bandit_scorer.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define EPPOCLIENT_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__AVX2__)
+#define EPPOCLIENT_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EPPOCLIENT_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace eppoclient {
+
+namespace internal {
+
+void accumulateProductsScalar(const double* coefficients, const double* values, size_t rows,
+                              size_t lanes, double* sums) {
+    for (size_t row = 0; row < rows; ++row) {
+        const double* c = coefficients + row * lanes;
+        const double* v = values + row * lanes;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            double product = c[lane] * v[lane];
+            sums[lane] += product;
+        }
+    }
+}
+
+namespace {
+
+#ifdef EPPOCLIENT_SIMD_SSE2
+void accumulateProductsSse2(const double* coefficients, const double* values, size_t rows,
+                            size_t lanes, double* sums) {
+    size_t vectorLanes = lanes - lanes % 2;
+    for (size_t row = 0; row < rows; ++row) {
+        const double* c = coefficients + row * lanes;
+        const double* v = values + row * lanes;
+        for (size_t lane = 0; lane < vectorLanes; lane += 2) {
+            __m128d product = _mm_mul_pd(_mm_loadu_pd(c + lane), _mm_loadu_pd(v + lane));
+            _mm_storeu_pd(sums + lane, _mm_add_pd(_mm_loadu_pd(sums + lane), product));
+        }
+        for (size_t lane = vectorLanes; lane < lanes; ++lane) {
+            double product = c[lane] * v[lane];
+            sums[lane] += product;
+        }
+    }
+}
+#endif
+
+#ifdef EPPOCLIENT_SIMD_AVX2
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+#endif
+void accumulateProductsAvx2(const double* coefficients, const double* values, size_t rows,
+                            size_t lanes, double* sums) {
+    size_t vectorLanes = lanes - lanes % 4;
+    for (size_t row = 0; row < rows; ++row) {
+        const double* c = coefficients + row * lanes;
+        const double* v = values + row * lanes;
+        for (size_t lane = 0; lane < vectorLanes; lane += 4) {
+            __m256d product = _mm256_mul_pd(_mm256_loadu_pd(c + lane), _mm256_loadu_pd(v + lane));
+            _mm256_storeu_pd(sums + lane, _mm256_add_pd(_mm256_loadu_pd(sums + lane), product));
+        }
+        for (size_t lane = vectorLanes; lane < lanes; ++lane) {
+            double product = c[lane] * v[lane];
+            sums[lane] += product;
+        }
+    }
+}
+#endif
+
+#ifdef EPPOCLIENT_SIMD_NEON
+void accumulateProductsNeon(const double* coefficients, const double* values, size_t rows,
+                            size_t lanes, double* sums) {
+    size_t vectorLanes = lanes - lanes % 2;
+    for (size_t row = 0; row < rows; ++row) {
+        const double* c = coefficients + row * lanes;
+        const double* v = values + row * lanes;
+        for (size_t lane = 0; lane < vectorLanes; lane += 2) {
+            float64x2_t product = vmulq_f64(vld1q_f64(c + lane), vld1q_f64(v + lane));
+            vst1q_f64(sums + lane, vaddq_f64(vld1q_f64(sums + lane), product));
+        }
+        for (size_t lane = vectorLanes; lane < lanes; ++lane) {
+            double product = c[lane] * v[lane];
+            sums[lane] += product;
+        }
+    }
+}
+#endif
+
+SimdLevel detectSimdLevel() {
+#if defined(EPPOCLIENT_SIMD_AVX2) && defined(__AVX2__)
+    return SimdLevel::AVX2;
+#elif defined(EPPOCLIENT_SIMD_AVX2)
+    return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(EPPOCLIENT_SIMD_SSE2)
+    return SimdLevel::SSE2;
+#elif defined(EPPOCLIENT_SIMD_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+}  // namespace
+
+SimdLevel activeSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+void accumulateProducts(const double* coefficients, const double* values, size_t rows,
+                        size_t lanes, double* sums) {
+    switch (activeSimdLevel()) {
+#ifdef EPPOCLIENT_SIMD_AVX2
+        case SimdLevel::AVX2:
+            accumulateProductsAvx2(coefficients, values, rows, lanes, sums);
+            return;
+#endif
+#ifdef EPPOCLIENT_SIMD_SSE2
+        case SimdLevel::SSE2:
+            accumulateProductsSse2(coefficients, values, rows, lanes, sums);
+            return;
+#endif
+#ifdef EPPOCLIENT_SIMD_NEON
+        case SimdLevel::NEON:
+            accumulateProductsNeon(coefficients, values, rows, lanes, sums);
+            return;
+#endif
+        default:
+            accumulateProductsScalar(coefficients, values, rows, lanes, sums);
+            return;
+    }
+}
+
+// ============================================================================
+// BanditActionScorer Implementation
+// ============================================================================
+
+void BanditActionScorer::reset(const CompiledBanditModel& model,
+                               const ContextAttributes& subjectAttributes) {
+    model_ = &model;
+    resolveBanditAttributes(model.subjectNumericAttributes, model.subjectCategoricalAttributes,
+                            subjectAttributes, subject_);
+    subjectNumericScores_.assign(model.actions.size(), 0.0);
+    subjectCategoricalScores_.assign(model.actions.size(), 0.0);
+    subjectScoresComputed_.assign(model.actions.size(), 0);
+    lanes_.clear();
+    actionNumericCoefficients_.clear();
+    actionNumericValues_.clear();
+    actionCategoricalValues_.clear();
+}
+
+void BanditActionScorer::addAction(const std::string& actionKey,
+                                   const ContextAttributes& actionAttributes) {
+    auto it = model_->actionIds.find(actionKey);
+    if (it == model_->actionIds.end()) {
+        addLane(nullptr, action_);
+        return;
+    }
+    resolveBanditAttributes(model_->actionNumericAttributes, model_->actionCategoricalAttributes,
+                            actionAttributes, action_);
+    addLane(&model_->actions[it->second], action_);
+}
+
+void BanditActionScorer::addAction(const std::string& actionKey,
+                                   const ResolvedBanditAttributes& actionAttributes) {
+    auto it = model_->actionIds.find(actionKey);
+    addLane(it != model_->actionIds.end() ? &model_->actions[it->second] : nullptr,
+            actionAttributes);
+}
+
+void BanditActionScorer::addLane(const CompiledBanditModel::Action* action,
+                                 const ResolvedBanditAttributes& actionAttributes) {
+    lanes_.push_back(Lane{action, actionNumericValues_.size(), actionCategoricalValues_.size()});
+    if (action == nullptr) {
+        return;
+    }
+
+    // Stage the action's terms; subject terms are read from the resolved subject when scoring
+    const auto& numeric = action->actionNumeric;
+    for (size_t i = 0; i < numeric.attributeIds.size(); ++i) {
+        uint32_t id = numeric.attributeIds[i];
+        if (actionAttributes.numericPresent[id]) {
+            actionNumericCoefficients_.push_back(numeric.coefficients[i]);
+            actionNumericValues_.push_back(actionAttributes.numericValues[id]);
+        } else {
+            actionNumericCoefficients_.push_back(numeric.missingValueCoefficients[i]);
+            actionNumericValues_.push_back(1.0);
+        }
+    }
+    const auto& categorical = action->actionCategorical;
+    for (size_t i = 0; i < categorical.attributeIds.size(); ++i) {
+        uint32_t slot = actionAttributes.categoricalSlots[categorical.attributeIds[i]];
+        actionCategoricalValues_.push_back(categorical.score(i, slot));
+    }
+}
+
+// Lay one coefficient group out row by row across lanes, padding with -0.0 * 1.0,
+// and add each lane's sum of the group to its score
+template <typename TermCount, typename FillLane>
+void BanditActionScorer::accumulateGroup(TermCount termCount, FillLane fillLane,
+                                         std::vector<double>& scores) {
+    const size_t lanes = lanes_.size();
+    size_t rows = 0;
+    for (const Lane& lane : lanes_) {
+        if (lane.action != nullptr) {
+            rows = std::max(rows, termCount(*lane.action));
+        }
+    }
+
+    coefficients_.assign(rows * lanes, -0.0);
+    values_.assign(rows * lanes, 1.0);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        if (lanes_[lane].action != nullptr) {
+            fillLane(lanes_[lane], [&](size_t row, double coefficient, double value) {
+                coefficients_[row * lanes + lane] = coefficient;
+                values_[row * lanes + lane] = value;
+            });
+        }
+    }
+
+    groupSums_.assign(lanes, 0.0);
+    accumulateProducts(coefficients_.data(), values_.data(), rows, lanes, groupSums_.data());
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        scores[lane] += groupSums_[lane];
+    }
+}
+
+void BanditActionScorer::score(double defaultActionScore, std::vector<double>& scores) {
+    scores.resize(lanes_.size());
+    for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+        scores[lane] = lanes_[lane].action != nullptr ? lanes_[lane].action->intercept : 0.0;
+    }
+
+    // Groups are added in the same order as in scoreAction()
+    accumulateGroup(
+        [](const CompiledBanditModel::Action& action) {
+            return action.actionNumeric.attributeIds.size();
+        },
+        [&](const Lane& lane, auto&& emit) {
+            size_t count = lane.action->actionNumeric.attributeIds.size();
+            for (size_t row = 0; row < count; ++row) {
+                emit(row, actionNumericCoefficients_[lane.numericOffset + row],
+                     actionNumericValues_[lane.numericOffset + row]);
+            }
+        },
+        scores);
+
+    accumulateGroup(
+        [](const CompiledBanditModel::Action& action) {
+            return action.actionCategorical.attributeIds.size();
+        },
+        [&](const Lane& lane, auto&& emit) {
+            size_t count = lane.action->actionCategorical.attributeIds.size();
+            for (size_t row = 0; row < count; ++row) {
+                emit(row, 1.0, actionCategoricalValues_[lane.categoricalOffset + row]);
+            }
+        },
+        scores);
+
+    // Subject score components depend only on the subject and the action's subject
+    // terms, so they are computed once per distinct set of subject terms
+    for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+        const CompiledBanditModel::Action* action = lanes_[lane].action;
+        if (action == nullptr) {
+            continue;
+        }
+        uint32_t id = action->subjectTermsId;
+        if (!subjectScoresComputed_[id]) {
+            subjectNumericScores_[id] = scoreNumericTerms(action->subjectNumeric, subject_);
+            subjectCategoricalScores_[id] =
+                scoreCategoricalTerms(action->subjectCategorical, subject_);
+            subjectScoresComputed_[id] = 1;
+        }
+        scores[lane] += subjectNumericScores_[id];
+        scores[lane] += subjectCategoricalScores_[id];
+    }
+
+    for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+        if (lanes_[lane].action == nullptr) {
+            scores[lane] = defaultActionScore;
+        }
+    }
+}
+
+}  // namespace internal
+
+}  // namespace eppoclient
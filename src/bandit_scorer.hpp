@@ -0,0 +1,113 @@
+#ifndef BANDIT_SCORER_HPP
+#define BANDIT_SCORER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bandit_model.hpp"
+#include "evalbandits.hpp"
+
+namespace eppoclient {
+
+// Internal namespace for implementation details not covered by semver
+namespace internal {
+
+// Instruction set used by accumulateProducts()
+enum class SimdLevel { SCALAR, SSE2, AVX2, NEON };
+
+// Get the instruction set accumulateProducts() uses on this CPU
+SimdLevel activeSimdLevel();
+
+/**
+ * Column-wise multiply-accumulate over a row-major matrix of lanes:
+ * sums[lane] += coefficients[row * lanes + lane] * values[row * lanes + lane],
+ * for every row in order.
+ *
+ * Uses AVX2 (selected at runtime), SSE2 or NEON where available. Every lane
+ * performs the same multiplications and additions in the same order as the
+ * scalar loop, without fused multiply-add, so the sums are bit-identical to
+ * accumulateProductsScalar() on every instruction set. This relies on the
+ * scalar code not being contracted into fused multiply-adds either, which the
+ * build ensures with -ffp-contract=off.
+ */
+void accumulateProducts(const double* coefficients, const double* values, size_t rows,
+                        size_t lanes, double* sums);
+
+// Scalar implementation of accumulateProducts()
+void accumulateProductsScalar(const double* coefficients, const double* values, size_t rows,
+                              size_t lanes, double* sums);
+
+/**
+ * BanditActionScorer - scores every action of a bandit evaluation at once
+ *
+ * Each action is a lane. The terms of each action coefficient group (numeric,
+ * categorical) are laid out row by row across lanes, as coefficient/value pairs:
+ * a present numeric attribute contributes coefficient * value, a missing one its
+ * missing value coefficient * 1.0, a categorical term 1.0 * its score, and lanes
+ * with fewer terms are padded with -0.0 * 1.0. The rows are then summed with SIMD
+ * multiply-adds across lanes. Since multiplying by 1.0 and adding -0.0 are
+ * exact, scores are bit-identical to scoreAction().
+ *
+ * The subject numeric and categorical components depend only on the subject and
+ * the action's subject terms. They are computed once per distinct set of subject
+ * terms (see CompiledBanditModel::Action::subjectTermsId) and added to every lane
+ * that shares it, in the same order as scoreAction().
+ *
+ * A scorer keeps its buffers between evaluations and is not thread-safe.
+ */
+class BanditActionScorer {
+public:
+    // Start scoring actions of a model for a subject
+    void reset(const CompiledBanditModel& model, const ContextAttributes& subjectAttributes);
+
+    // Add an action to score; actions are scored in the order they are added
+    void addAction(const std::string& actionKey, const ContextAttributes& actionAttributes);
+
+    // Add an action whose attributes are resolved against the model's action attribute tables
+    void addAction(const std::string& actionKey, const ResolvedBanditAttributes& actionAttributes);
+
+    // Score the added actions; actions without coefficients get defaultActionScore
+    void score(double defaultActionScore, std::vector<double>& scores);
+
+private:
+    struct Lane {
+        const CompiledBanditModel::Action* action;  // nullptr if the action has no coefficients
+        size_t numericOffset;                       // Into actionNumericCoefficients_/Values_
+        size_t categoricalOffset;                   // Into actionCategoricalValues_
+    };
+
+    const CompiledBanditModel* model_ = nullptr;
+    ResolvedBanditAttributes subject_;
+    ResolvedBanditAttributes action_;
+    std::vector<Lane> lanes_;
+
+    // Per lane, the coefficient/value pair of each action numeric term and the
+    // score of each action categorical term, in term order
+    std::vector<double> actionNumericCoefficients_;
+    std::vector<double> actionNumericValues_;
+    std::vector<double> actionCategoricalValues_;
+
+    // Subject score components, indexed by subject terms ID and computed at most
+    // once per reset()
+    std::vector<double> subjectNumericScores_;
+    std::vector<double> subjectCategoricalScores_;
+    std::vector<uint8_t> subjectScoresComputed_;
+
+    // Row-major group matrices and sums, one column per lane
+    std::vector<double> coefficients_;
+    std::vector<double> values_;
+    std::vector<double> groupSums_;
+
+    // Add a lane for an action, or for one without coefficients if action is nullptr
+    void addLane(const CompiledBanditModel::Action* action,
+                 const ResolvedBanditAttributes& actionAttributes);
+
+    template <typename TermCount, typename FillLane>
+    void accumulateGroup(TermCount termCount, FillLane fillLane, std::vector<double>& scores);
+};
+
+}  // namespace internal
+
+}  // namespace eppoclient
+
+#endif  // BANDIT_SCORER_HPP
@@ -9,136 +9,158 @@ namespace eppoclient {
 EppoClient::EppoClient(std::shared_ptr<ConfigurationStore> configStore,
                        std::shared_ptr<AssignmentLogger> assignmentLogger,
                        std::shared_ptr<BanditLogger> banditLogger,
-                       std::shared_ptr<ApplicationLogger> applicationLogger)
+                       std::shared_ptr<ApplicationLogger> applicationLogger,
+                       size_t assignmentCacheSize)
     : configurationStore_(configStore),
       assignmentLogger_(assignmentLogger ? assignmentLogger
                                          : std::make_shared<NoOpAssignmentLogger>()),
       banditLogger_(banditLogger ? banditLogger : std::make_shared<NoOpBanditLogger>()),
       applicationLogger_(applicationLogger ? applicationLogger
-                                           : std::make_shared<NoOpApplicationLogger>()) {}
+                                           : std::make_shared<NoOpApplicationLogger>()),
+      assignmentResultCache_(assignmentCacheSize > 0
+                                 ? std::make_shared<AssignmentResultCache>(assignmentCacheSize)
+                                 : nullptr) {}
+
+EvaluationClient EppoClient::evaluationClient(
+    const std::shared_ptr<const Configuration>& config) const {
+    if (assignmentResultCache_) {
+        return EvaluationClient(config, *assignmentLogger_, *banditLogger_, *applicationLogger_,
+                                *assignmentResultCache_);
+    }
+    return EvaluationClient(*config, *assignmentLogger_, *banditLogger_, *applicationLogger_);
+}
 
-EvaluationClient EppoClient::evaluationClient(const Configuration& config) const {
-    return EvaluationClient(config, *assignmentLogger_, *banditLogger_, *applicationLogger_);
+EvaluationSession EppoClient::session() const {
+    return EvaluationSession(configurationStore_->getConfiguration(), assignmentLogger_,
+                             banditLogger_, applicationLogger_, assignmentResultCache_);
 }
 
-bool EppoClient::getBooleanAssignment(const std::string& flagKey, const std::string& subjectKey,
+bool EppoClient::getBooleanAssignment(std::string_view flagKey, std::string_view subjectKey,
                                       const Attributes& subjectAttributes, bool defaultValue) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getBooleanAssignment(flagKey, subjectKey, subjectAttributes,
-                                                          defaultValue);
+    return evaluationClient(config).getBooleanAssignment(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue);
 }
 
-double EppoClient::getNumericAssignment(const std::string& flagKey, const std::string& subjectKey,
+double EppoClient::getNumericAssignment(std::string_view flagKey, std::string_view subjectKey,
                                         const Attributes& subjectAttributes, double defaultValue) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getNumericAssignment(flagKey, subjectKey, subjectAttributes,
-                                                          defaultValue);
+    return evaluationClient(config).getNumericAssignment(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue);
 }
 
-int64_t EppoClient::getIntegerAssignment(const std::string& flagKey, const std::string& subjectKey,
+int64_t EppoClient::getIntegerAssignment(std::string_view flagKey, std::string_view subjectKey,
                                          const Attributes& subjectAttributes,
                                          int64_t defaultValue) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getIntegerAssignment(flagKey, subjectKey, subjectAttributes,
-                                                          defaultValue);
+    return evaluationClient(config).getIntegerAssignment(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue);
 }
 
-std::string EppoClient::getStringAssignment(const std::string& flagKey,
-                                            const std::string& subjectKey,
+std::string EppoClient::getStringAssignment(std::string_view flagKey, std::string_view subjectKey,
                                             const Attributes& subjectAttributes,
                                             const std::string& defaultValue) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getStringAssignment(flagKey, subjectKey, subjectAttributes,
-                                                         defaultValue);
+    return evaluationClient(config).getStringAssignment(flagKey, subjectKey, subjectAttributes,
+                                                        defaultValue);
 }
 
-nlohmann::json EppoClient::getJSONAssignment(const std::string& flagKey,
-                                             const std::string& subjectKey,
+nlohmann::json EppoClient::getJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
                                              const Attributes& subjectAttributes,
                                              const nlohmann::json& defaultValue) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getJSONAssignment(flagKey, subjectKey, subjectAttributes,
-                                                       defaultValue);
+    return evaluationClient(config).getJSONAssignment(flagKey, subjectKey, subjectAttributes,
+                                                      defaultValue);
 }
 
-std::string EppoClient::getSerializedJSONAssignment(const std::string& flagKey,
-                                                    const std::string& subjectKey,
+std::string EppoClient::getSerializedJSONAssignment(std::string_view flagKey,
+                                                    std::string_view subjectKey,
                                                     const Attributes& subjectAttributes,
                                                     const std::string& defaultValue) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getSerializedJSONAssignment(flagKey, subjectKey,
-                                                                 subjectAttributes, defaultValue);
+    return evaluationClient(config).getSerializedJSONAssignment(flagKey, subjectKey,
+                                                                subjectAttributes, defaultValue);
 }
 
-BanditResult EppoClient::getBanditAction(const std::string& flagKey, const std::string& subjectKey,
+BanditResult EppoClient::getBanditAction(std::string_view flagKey, std::string_view subjectKey,
                                          const ContextAttributes& subjectAttributes,
                                          const std::map<std::string, ContextAttributes>& actions,
                                          const std::string& defaultVariation) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getBanditAction(flagKey, subjectKey, subjectAttributes,
-                                                     actions, defaultVariation);
+    return evaluationClient(config).getBanditAction(flagKey, subjectKey, subjectAttributes, actions,
+                                                    defaultVariation);
+}
+
+BanditResult EppoClient::getBanditActionColumnar(std::string_view flagKey,
+                                                 std::string_view subjectKey,
+                                                 const ContextAttributes& subjectAttributes,
+                                                 const BanditActionTable& actions,
+                                                 const std::string& defaultVariation) {
+    auto config = configurationStore_->getConfiguration();
+    return evaluationClient(config).getBanditActionColumnar(flagKey, subjectKey, subjectAttributes,
+                                                            actions, defaultVariation);
 }
 
 EvaluationResult<std::string> EppoClient::getBanditActionDetails(
-    const std::string& flagKey, const std::string& subjectKey,
+    std::string_view flagKey, std::string_view subjectKey,
     const ContextAttributes& subjectAttributes,
-    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation) {
+    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation,
+    EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getBanditActionDetails(flagKey, subjectKey, subjectAttributes,
-                                                            actions, defaultVariation);
+    return evaluationClient(config).getBanditActionDetails(flagKey, subjectKey, subjectAttributes,
+                                                           actions, defaultVariation, traceLevel);
 }
 
 // ============================================================================
 // Assignment Details Methods
 // ============================================================================
 
-EvaluationResult<bool> EppoClient::getBooleanAssignmentDetails(const std::string& flagKey,
-                                                               const std::string& subjectKey,
-                                                               const Attributes& subjectAttributes,
-                                                               bool defaultValue) {
+EvaluationResult<bool> EppoClient::getBooleanAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    bool defaultValue, EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getBooleanAssignmentDetails(flagKey, subjectKey,
-                                                                 subjectAttributes, defaultValue);
+    return evaluationClient(config).getBooleanAssignmentDetails(
+        flagKey, subjectKey, subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<int64_t> EppoClient::getIntegerAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    int64_t defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    int64_t defaultValue, EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getIntegerAssignmentDetails(flagKey, subjectKey,
-                                                                 subjectAttributes, defaultValue);
+    return evaluationClient(config).getIntegerAssignmentDetails(
+        flagKey, subjectKey, subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<double> EppoClient::getNumericAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    double defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    double defaultValue, EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getNumericAssignmentDetails(flagKey, subjectKey,
-                                                                 subjectAttributes, defaultValue);
+    return evaluationClient(config).getNumericAssignmentDetails(
+        flagKey, subjectKey, subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<std::string> EppoClient::getStringAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    const std::string& defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const std::string& defaultValue, EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getStringAssignmentDetails(flagKey, subjectKey,
-                                                                subjectAttributes, defaultValue);
+    return evaluationClient(config).getStringAssignmentDetails(
+        flagKey, subjectKey, subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<nlohmann::json> EppoClient::getJsonAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    const nlohmann::json& defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const nlohmann::json& defaultValue, EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getJsonAssignmentDetails(flagKey, subjectKey,
-                                                              subjectAttributes, defaultValue);
+    return evaluationClient(config).getJsonAssignmentDetails(flagKey, subjectKey, subjectAttributes,
+                                                             defaultValue, traceLevel);
 }
 
 EvaluationResult<std::string> EppoClient::getSerializedJsonAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    const std::string& defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const std::string& defaultValue, EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getSerializedJsonAssignmentDetails(
-        flagKey, subjectKey, subjectAttributes, defaultValue);
+    return evaluationClient(config).getSerializedJsonAssignmentDetails(
+        flagKey, subjectKey, subjectAttributes, defaultValue, traceLevel);
 }
 
 
@@ -3,12 +3,16 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include "application_logger.hpp"
+#include "assignment_result_cache.hpp"
 #include "config_response.hpp"
 #include "configuration_store.hpp"
 #include "evalbandits.hpp"
 #include "evalflags.hpp"
 #include "evaluation_client.hpp"
+#include "evaluation_session.hpp"
+#include "flag_handle.hpp"
 #include "rules.hpp"
 
 namespace eppoclient {
@@ -32,6 +36,11 @@ public:
     void logBanditAction(const BanditEvent&) override {
         // No-op: do nothing
     }
+
+    bool shouldLogBanditAction(const std::string&, const std::string&, const std::string&,
+                               const std::string&) override {
+        return false;
+    }
 };
 
 /**
@@ -64,117 +73,166 @@ private:
     std::shared_ptr<AssignmentLogger> assignmentLogger_;
     std::shared_ptr<BanditLogger> banditLogger_;
     std::shared_ptr<ApplicationLogger> applicationLogger_;
+    std::shared_ptr<AssignmentResultCache> assignmentResultCache_;
 
     // Helper method to create EvaluationClient instance with given configuration
-    EvaluationClient evaluationClient(const Configuration& config) const;
+    EvaluationClient evaluationClient(const std::shared_ptr<const Configuration>& config) const;
 
 public:
-    // Constructor
+    /**
+     * Constructor
+     *
+     * When assignmentCacheSize is positive, up to that many assignment results are
+     * cached by flag key, subject key and subject attributes, so evaluating the same
+     * flag for the same subject again skips flag evaluation. Every cached
+     * evaluation logs the assignment event stored with the result again, with the
+     * timestamp of the evaluation that produced it; wrap the assignment logger with
+     * NewLruAssignmentLogger() to deduplicate these events. Results are cached per
+     * configuration snapshot, so results of a replaced configuration are not used.
+     * Only the typed assignment getters (and bandit variations) use the cache.
+     */
     EppoClient(std::shared_ptr<ConfigurationStore> configStore,
                std::shared_ptr<AssignmentLogger> assignmentLogger = nullptr,
                std::shared_ptr<BanditLogger> banditLogger = nullptr,
-               std::shared_ptr<ApplicationLogger> applicationLogger = nullptr);
+               std::shared_ptr<ApplicationLogger> applicationLogger = nullptr,
+               size_t assignmentCacheSize = 0);
 
     // Get boolean assignment
-    bool getBooleanAssignment(const std::string& flagKey, const std::string& subjectKey,
+    bool getBooleanAssignment(std::string_view flagKey, std::string_view subjectKey,
                               const Attributes& subjectAttributes, bool defaultValue);
 
     // Get numeric assignment
-    double getNumericAssignment(const std::string& flagKey, const std::string& subjectKey,
+    double getNumericAssignment(std::string_view flagKey, std::string_view subjectKey,
                                 const Attributes& subjectAttributes, double defaultValue);
 
     // Get integer assignment
-    int64_t getIntegerAssignment(const std::string& flagKey, const std::string& subjectKey,
+    int64_t getIntegerAssignment(std::string_view flagKey, std::string_view subjectKey,
                                  const Attributes& subjectAttributes, int64_t defaultValue);
 
     // Get string assignment
-    std::string getStringAssignment(const std::string& flagKey, const std::string& subjectKey,
+    std::string getStringAssignment(std::string_view flagKey, std::string_view subjectKey,
                                     const Attributes& subjectAttributes,
                                     const std::string& defaultValue);
 
     // Get JSON assignment
-    nlohmann::json getJSONAssignment(const std::string& flagKey, const std::string& subjectKey,
+    nlohmann::json getJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
                                      const Attributes& subjectAttributes,
                                      const nlohmann::json& defaultValue);
 
     // Get serialized JSON assignment (returns stringified JSON)
-    std::string getSerializedJSONAssignment(const std::string& flagKey,
-                                            const std::string& subjectKey,
+    std::string getSerializedJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
                                             const Attributes& subjectAttributes,
                                             const std::string& defaultValue);
 
     // Get bandit action
-    BanditResult getBanditAction(const std::string& flagKey, const std::string& subjectKey,
+    BanditResult getBanditAction(std::string_view flagKey, std::string_view subjectKey,
                                  const ContextAttributes& subjectAttributes,
                                  const std::map<std::string, ContextAttributes>& actions,
                                  const std::string& defaultVariation);
 
+    // Get bandit action from a columnar action table
+    BanditResult getBanditActionColumnar(std::string_view flagKey, std::string_view subjectKey,
+                                         const ContextAttributes& subjectAttributes,
+                                         const BanditActionTable& actions,
+                                         const std::string& defaultVariation);
+
     // ========== Assignment Details Methods ==========
+    // traceLevel sets how much of each flag evaluation the details record
 
     // Get boolean assignment with details
-    EvaluationResult<bool> getBooleanAssignmentDetails(const std::string& flagKey,
-                                                       const std::string& subjectKey,
-                                                       const Attributes& subjectAttributes,
-                                                       bool defaultValue);
+    EvaluationResult<bool> getBooleanAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        bool defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get integer assignment with details
-    EvaluationResult<int64_t> getIntegerAssignmentDetails(const std::string& flagKey,
-                                                          const std::string& subjectKey,
-                                                          const Attributes& subjectAttributes,
-                                                          int64_t defaultValue);
+    EvaluationResult<int64_t> getIntegerAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        int64_t defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get numeric assignment with details
-    EvaluationResult<double> getNumericAssignmentDetails(const std::string& flagKey,
-                                                         const std::string& subjectKey,
-                                                         const Attributes& subjectAttributes,
-                                                         double defaultValue);
+    EvaluationResult<double> getNumericAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        double defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get string assignment with details
-    EvaluationResult<std::string> getStringAssignmentDetails(const std::string& flagKey,
-                                                             const std::string& subjectKey,
-                                                             const Attributes& subjectAttributes,
-                                                             const std::string& defaultValue);
+    EvaluationResult<std::string> getStringAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const std::string& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get JSON assignment with details
-    EvaluationResult<nlohmann::json> getJsonAssignmentDetails(const std::string& flagKey,
-                                                              const std::string& subjectKey,
-                                                              const Attributes& subjectAttributes,
-                                                              const nlohmann::json& defaultValue);
+    EvaluationResult<nlohmann::json> getJsonAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const nlohmann::json& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get serialized JSON assignment with details
     EvaluationResult<std::string> getSerializedJsonAssignmentDetails(
-        const std::string& flagKey, const std::string& subjectKey,
-        const Attributes& subjectAttributes, const std::string& defaultValue);
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const std::string& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get bandit action with details
     EvaluationResult<std::string> getBanditActionDetails(
-        const std::string& flagKey, const std::string& subjectKey,
+        std::string_view flagKey, std::string_view subjectKey,
         const ContextAttributes& subjectAttributes,
         const std::map<std::string, ContextAttributes>& actions,
-        const std::string& defaultVariation);
+        const std::string& defaultVariation,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Generic get assignment details (for advanced use cases)
     template <typename T>
-    EvaluationResult<T> getAssignmentDetails(VariationType variationType,
-                                             const std::string& flagKey,
-                                             const std::string& subjectKey,
-                                             const Attributes& subjectAttributes,
-                                             const T& defaultValue);
+    EvaluationResult<T> getAssignmentDetails(
+        VariationType variationType, std::string_view flagKey, std::string_view subjectKey,
+        const Attributes& subjectAttributes, const T& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get configuration store
     ConfigurationStore& getConfigurationStore() const { return *configurationStore_; }
+
+    /**
+     * Get a handle for evaluating a flag repeatedly without looking it up by key
+     * on every call. T is one of bool, int64_t, double, std::string or nlohmann::json.
+     *
+     * @code
+     * auto darkMode = client.flag<bool>("dark-mode");
+     * bool enabled = darkMode.getAssignment("user-123", attrs, false);
+     * @endcode
+     */
+    template <typename T>
+    FlagHandle<T> flag(std::string_view flagKey) const {
+        return FlagHandle<T>(std::string(flagKey), configurationStore_, assignmentLogger_,
+                             banditLogger_, applicationLogger_, assignmentResultCache_);
+    }
+
+    /**
+     * Start a session evaluating flags against the current configuration.
+     *
+     * The session loads the configuration once and reuses it, together with its
+     * evaluation state, for every call, which is cheaper than calling the client
+     * getters repeatedly and guarantees that all flags evaluated through it see the
+     * same configuration.
+     *
+     * @code
+     * auto session = client.session();
+     * bool enabled = session.getBooleanAssignment("my-flag", "user-123", attrs, false);
+     * @endcode
+     */
+    EvaluationSession session() const;
 };
 
 // Template method implementation
 template <typename T>
 EvaluationResult<T> EppoClient::getAssignmentDetails(VariationType variationType,
-                                                     const std::string& flagKey,
-                                                     const std::string& subjectKey,
+                                                     std::string_view flagKey,
+                                                     std::string_view subjectKey,
                                                      const Attributes& subjectAttributes,
-                                                     const T& defaultValue) {
+                                                     const T& defaultValue,
+                                                     EvaluationTraceLevel traceLevel) {
     auto config = configurationStore_->getConfiguration();
-    return evaluationClient(*config).getAssignmentDetails<T>(variationType, flagKey, subjectKey,
-                                                             subjectAttributes, defaultValue);
+    return evaluationClient(config).getAssignmentDetails<T>(variationType, flagKey, subjectKey,
+                                                            subjectAttributes, defaultValue,
+                                                            traceLevel);
 }
 
 }  // namespace eppoclient
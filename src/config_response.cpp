@@ -1,5 +1,7 @@
 #include "config_response.hpp"
 #include <semver/semver.hpp>
+#include <algorithm>
+#include <numeric>
 #include "json_utils.hpp"
 #include "rules.hpp"
 #include "time_utils.hpp"
@@ -489,7 +491,9 @@ Condition::Condition()
       semVerValue(nullptr),
       semVerValueValid(false),
       regexValue(nullptr),
-      regexValueValid(false) {}
+      regexValueValid(false),
+      attributeId(std::nullopt),
+      patternSetIndex(std::nullopt) {}
 
 void Condition::precompute() {
     // Try to parse as numeric value for performance
@@ -536,11 +540,146 @@ void to_json(nlohmann::json& j, const Condition& c) {
     j = nlohmann::json{{"operator", c.op}, {"attribute", c.attribute}, {"value", c.value}};
 }
 
+// Rule implementation
+void Rule::precompute() {
+    for (auto& condition : conditions) {
+        condition.precompute();
+    }
+    updateConditionOrder();
+}
+
+void Rule::updateConditionOrder() {
+    // A condition's rank is its cost divided by the probability that it fails,
+    // i.e. the expected cost of rejecting the subject with it. Without
+    // statistics the failure probability is 1/2 for every condition, which
+    // orders conditions by cost alone.
+    std::vector<double> ranks;
+    ranks.reserve(conditions.size());
+    for (const auto& condition : conditions) {
+        double evaluations = 0.0;
+        double failures = 0.0;
+        if (condition.statistics) {
+            evaluations = static_cast<double>(
+                condition.statistics->evaluations.load(std::memory_order_relaxed));
+            failures = static_cast<double>(
+                condition.statistics->failures.load(std::memory_order_relaxed));
+        }
+        double failureProbability = (failures + 1.0) / (evaluations + 2.0);
+        ranks.push_back(internal::estimateConditionCost(condition) / failureProbability);
+    }
+
+    conditionOrder.resize(conditions.size());
+    std::iota(conditionOrder.begin(), conditionOrder.end(), 0);
+    std::stable_sort(conditionOrder.begin(), conditionOrder.end(),
+                     [&ranks](size_t a, size_t b) { return ranks[a] < ranks[b]; });
+}
+
 // Rule JSON conversion
 void to_json(nlohmann::json& j, const Rule& r) {
     j = nlohmann::json{{"conditions", r.conditions}};
 }
 
+// SplitIndex implementation
+void SplitIndex::build(const std::vector<Split>& splits) {
+    valid = false;
+    splitCount = splits.size();
+    words = (splits.size() + 63) / 64;
+    salts.clear();
+    allSplits.assign(words, 0);
+    for (size_t i = 0; i < splits.size(); ++i) {
+        allSplits[i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    // Distinct salts, in order of first use
+    for (const auto& split : splits) {
+        for (const auto& shard : split.shards) {
+            auto it = std::find_if(salts.begin(), salts.end(), [&shard](const SaltTable& table) {
+                return table.salt == shard.salt;
+            });
+            if (it == salts.end()) {
+                salts.push_back(SaltTable{shard.salt, {}, {}});
+            }
+        }
+    }
+
+    for (auto& table : salts) {
+        for (const auto& split : splits) {
+            for (const auto& shard : split.shards) {
+                if (shard.salt != table.salt) {
+                    continue;
+                }
+                for (const auto& range : shard.ranges) {
+                    table.boundaries.push_back(range.start);
+                    table.boundaries.push_back(range.end);
+                }
+            }
+        }
+        std::sort(table.boundaries.begin(), table.boundaries.end());
+        table.boundaries.erase(std::unique(table.boundaries.begin(), table.boundaries.end()),
+                               table.boundaries.end());
+
+        // Every value in a region is accepted by the same shards, so check one
+        size_t regions = table.boundaries.size() + 1;
+        table.masks.assign(regions * words, 0);
+        for (size_t region = 0; region < regions; ++region) {
+            int64_t value = table.boundaries.empty() ? 0
+                            : region == 0          ? table.boundaries.front() - 1
+                                                   : table.boundaries[region - 1];
+            for (size_t i = 0; i < splits.size(); ++i) {
+                bool accepted = true;
+                for (const auto& shard : splits[i].shards) {
+                    if (shard.salt != table.salt) {
+                        continue;
+                    }
+                    bool inRange = false;
+                    for (const auto& range : shard.ranges) {
+                        if (value >= range.start && value < range.end) {
+                            inRange = true;
+                            break;
+                        }
+                    }
+                    if (!inRange) {
+                        accepted = false;
+                        break;
+                    }
+                }
+                if (accepted) {
+                    table.masks[region * words + i / 64] |= uint64_t(1) << (i % 64);
+                }
+            }
+        }
+    }
+
+    valid = true;
+}
+
+// Allocation implementation
+void Allocation::precompute() {
+    for (auto& rule : rules) {
+        rule.precompute();
+    }
+    updateRuleOrder();
+    splitIndex.build(splits);
+}
+
+void Allocation::updateRuleOrder() {
+    // A rule costs at most the sum of its conditions
+    std::vector<double> costs;
+    costs.reserve(rules.size());
+    for (const auto& rule : rules) {
+        double cost = 0.0;
+        for (const auto& condition : rule.conditions) {
+            cost += internal::estimateConditionCost(condition);
+        }
+        costs.push_back(cost);
+    }
+
+    ruleOrder.resize(rules.size());
+    std::iota(ruleOrder.begin(), ruleOrder.end(), 0);
+    std::stable_sort(ruleOrder.begin(), ruleOrder.end(),
+                     [&costs](size_t a, size_t b) { return costs[a] < costs[b]; });
+}
+
 // Allocation JSON conversion
 void to_json(nlohmann::json& j, const Allocation& a) {
     j = nlohmann::json{{"key", a.key}, {"rules", a.rules}, {"splits", a.splits}};
@@ -592,11 +731,7 @@ void FlagConfiguration::precompute() {
 
     // Precompute conditions in all allocations
     for (auto& allocation : allocations) {
-        for (auto& rule : allocation.rules) {
-            for (auto& condition : rule.conditions) {
-                condition.precompute();
-            }
-        }
+        allocation.precompute();
     }
 }
 
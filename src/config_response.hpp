@@ -1,6 +1,7 @@
 #ifndef CONFIG_RESPONSE_HPP
 #define CONFIG_RESPONSE_HPP
 
+#include <atomic>
 #include <chrono>
 #include <istream>
 #include <memory>
@@ -66,6 +67,12 @@ struct Split {
 // serialization for the nlohmann::json library
 void to_json(nlohmann::json& j, const Split& s);
 
+// Observed outcomes of a condition, collected when enabled on the Configuration
+struct ConditionStatistics {
+    std::atomic<uint64_t> evaluations{0};
+    std::atomic<uint64_t> failures{0};
+};
+
 // Condition structure
 struct Condition {
     Operator op;  // operator is a C++ keyword, using op
@@ -79,6 +86,9 @@ struct Condition {
     bool semVerValueValid;
     std::shared_ptr<re2::RE2> regexValue;  // Precompiled RE2 pattern
     bool regexValueValid;
+    std::optional<size_t> attributeId;  // Dense attribute ID assigned by Configuration
+    std::optional<size_t> patternSetIndex;  // Index in the attribute's pattern set, if any
+    std::shared_ptr<ConditionStatistics> statistics;  // Observed outcomes, if collected
 
     Condition();
     void precompute();
@@ -90,11 +100,49 @@ void to_json(nlohmann::json& j, const Condition& c);
 // Rule structure - contains multiple conditions (AND logic)
 struct Rule {
     std::vector<Condition> conditions;
+
+    // Order in which conditions are evaluated, cheapest and most selective
+    // first (not serialized). Empty means configuration order.
+    std::vector<size_t> conditionOrder;
+
+    void precompute();
+
+    // Order conditions by estimated cost, weighted by observed failure rates
+    // when statistics are collected. Does not change which subjects match.
+    void updateConditionOrder();
 };
 
 // serialization for the nlohmann::json library
 void to_json(nlohmann::json& j, const Rule& r);
 
+// Precomputed split lookup for an allocation (not serialized)
+//
+// For every distinct shard salt used by the allocation's splits, the shard
+// value space is cut at every range boundary into regions. Each region holds
+// a bitmask of the splits whose shards with that salt accept every value in
+// the region (splits without a shard for the salt accept all values). The
+// matching split is the lowest bit set in the AND of the subject's region
+// masks across salts, so each salt is hashed once and located with a binary
+// search instead of scanning every split's ranges.
+struct SplitIndex {
+    struct SaltTable {
+        std::string salt;
+        // Sorted, distinct range boundaries. Region r is [boundaries[r - 1], boundaries[r]),
+        // with region 0 below the first boundary and the last region above the last one.
+        std::vector<int64_t> boundaries;
+        // (boundaries.size() + 1) masks of `words` 64-bit words each
+        std::vector<uint64_t> masks;
+    };
+
+    bool valid = false;
+    size_t splitCount = 0;           // Number of splits the index was built for
+    size_t words = 0;                // 64-bit words per mask
+    std::vector<uint64_t> allSplits;  // Mask of every split, used when there are no salts
+    std::vector<SaltTable> salts;
+
+    void build(const std::vector<Split>& splits);
+};
+
 // Allocation structure
 struct Allocation {
     std::string key;
@@ -103,6 +151,19 @@ struct Allocation {
     std::optional<std::chrono::system_clock::time_point> endAt;
     std::vector<Split> splits;
     std::optional<bool> doLog;
+
+    // Order in which rules are evaluated, cheapest first (not serialized).
+    // Empty means configuration order.
+    std::vector<size_t> ruleOrder;
+
+    // Shard value -> split lookup (not serialized)
+    SplitIndex splitIndex;
+
+    // Precompute conditions, rule order and the split index
+    void precompute();
+
+    // Order rules by estimated cost. Does not change which subjects match.
+    void updateRuleOrder();
 };
 
 // serialization for the nlohmann::json library
@@ -140,6 +201,11 @@ struct FlagConfiguration {
                        std::variant<std::string, int64_t, double, bool, nlohmann::json>>
         parsedVariations;
 
+    // Whether two or more regex conditions of the flag on the same attribute are
+    // matched with the attribute's pattern set, so resolving a subject's attributes
+    // pays off even for a single evaluation (set by Configuration, not serialized)
+    bool usesPatternSets = false;
+
     FlagConfiguration();
     void precompute();
 };
@@ -1,4 +1,5 @@
 #include "configuration.hpp"
+#include <algorithm>
 #include <nlohmann/json.hpp>
 
 namespace eppoclient {
@@ -8,8 +9,9 @@ Configuration::Configuration(ConfigResponse response)
 
 Configuration::Configuration(ConfigResponse flagsResponse, BanditResponse banditsResponse)
     : flags_(std::move(flagsResponse)), bandits_(std::move(banditsResponse)) {
-    // Precompute flag configurations
+    // Precompute flag configurations and compile bandit models
     flags_.precompute();
+    bandits_.precompute();
 
     // Build banditFlagAssociations map for O(1) lookup during evaluation
     // Iterate through all bandit variations in the config response
@@ -26,9 +28,131 @@ Configuration::Configuration(ConfigResponse flagsResponse, BanditResponse bandit
             byVariation[variationValue] = banditVariation;
         }
     }
+
+    // Assign dense IDs to every attribute referenced by a condition
+    for (auto& [flagKey, flag] : flags_.flags) {
+        for (auto& allocation : flag.allocations) {
+            for (auto& rule : allocation.rules) {
+                for (auto& condition : rule.conditions) {
+                    auto [it, inserted] =
+                        attributeIds_.emplace(condition.attribute, attributeNames_.size());
+                    if (inserted) {
+                        attributeNames_.push_back(condition.attribute);
+                    }
+                    condition.attributeId = it->second;
+                }
+            }
+        }
+    }
+
+    buildAttributePatternSets();
+    buildFlagIndex();
+}
+
+Configuration::Configuration(const Configuration& other)
+    : flags_(other.flags_),
+      bandits_(other.bandits_),
+      attributeIds_(other.attributeIds_),
+      attributeNames_(other.attributeNames_),
+      attributePatternSets_(other.attributePatternSets_),
+      banditFlagAssociations_(other.banditFlagAssociations_) {
+    buildFlagIndex();
+}
+
+Configuration& Configuration::operator=(const Configuration& other) {
+    if (this != &other) {
+        Configuration copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+void Configuration::buildFlagIndex() {
+    flagIndex_.clear();
+    flagIndex_.reserve(flags_.flags.size());
+    for (const auto& [flagKey, flag] : flags_.flags) {
+        flagIndex_.emplace(std::string_view(flagKey), &flag);
+    }
 }
 
-bool Configuration::getBanditVariant(const std::string& flagKey, const std::string& variation,
+// Group the regex patterns of MATCHES/NOT_MATCHES conditions by attribute and
+// compile each group of two or more distinct patterns into an RE2::Set, then
+// record which flags match several patterns of one set
+void Configuration::buildAttributePatternSets() {
+    std::vector<std::vector<Condition*>> regexConditions(attributeNames_.size());
+    for (auto& [flagKey, flag] : flags_.flags) {
+        for (auto& allocation : flag.allocations) {
+            for (auto& rule : allocation.rules) {
+                for (auto& condition : rule.conditions) {
+                    if ((condition.op == Operator::MATCHES ||
+                         condition.op == Operator::NOT_MATCHES) &&
+                        condition.regexValueValid && condition.regexValue &&
+                        condition.attributeId.has_value()) {
+                        regexConditions[*condition.attributeId].push_back(&condition);
+                    }
+                }
+            }
+        }
+    }
+
+    attributePatternSets_.assign(attributeNames_.size(), AttributePatternSet());
+    for (size_t id = 0; id < regexConditions.size(); ++id) {
+        // Distinct pattern -> index in the set
+        std::unordered_map<std::string, int> patternIndexes;
+        for (const Condition* condition : regexConditions[id]) {
+            patternIndexes.emplace(condition->regexValue->pattern(), -1);
+        }
+        if (patternIndexes.size() < 2) {
+            continue;
+        }
+
+        // Use the same options the conditions' patterns were compiled with
+        const re2::RE2::Options& options = regexConditions[id].front()->regexValue->options();
+        auto patterns = std::make_shared<re2::RE2::Set>(options, re2::RE2::UNANCHORED);
+        size_t size = 0;
+        for (auto& [pattern, index] : patternIndexes) {
+            index = patterns->Add(pattern, nullptr);
+            if (index >= 0) {
+                ++size;
+            }
+        }
+        if (size < 2 || !patterns->Compile()) {
+            continue;
+        }
+
+        attributePatternSets_[id] = AttributePatternSet{patterns, size};
+        for (Condition* condition : regexConditions[id]) {
+            int index = patternIndexes[condition->regexValue->pattern()];
+            if (index >= 0) {
+                condition->patternSetIndex = static_cast<size_t>(index);
+            }
+        }
+    }
+
+    for (auto& [flagKey, flag] : flags_.flags) {
+        // Attribute ID -> distinct pattern set indexes of the flag's conditions
+        std::unordered_map<size_t, std::vector<size_t>> patternSetIndexes;
+        for (const auto& allocation : flag.allocations) {
+            for (const auto& rule : allocation.rules) {
+                for (const auto& condition : rule.conditions) {
+                    if (!condition.patternSetIndex.has_value()) {
+                        continue;
+                    }
+                    auto& indexes = patternSetIndexes[*condition.attributeId];
+                    if (std::find(indexes.begin(), indexes.end(), *condition.patternSetIndex) ==
+                        indexes.end()) {
+                        indexes.push_back(*condition.patternSetIndex);
+                    }
+                }
+            }
+        }
+        flag.usesPatternSets = std::any_of(
+            patternSetIndexes.begin(), patternSetIndexes.end(),
+            [](const auto& entry) { return entry.second.size() >= 2; });
+    }
+}
+
+bool Configuration::getBanditVariant(std::string_view flagKey, std::string_view variation,
                                      BanditVariation& result) const {
     auto flagIt = banditFlagAssociations_.find(flagKey);
     if (flagIt == banditFlagAssociations_.end()) {
@@ -45,15 +169,15 @@ bool Configuration::getBanditVariant(const std::string& flagKey, const std::stri
     return true;
 }
 
-const FlagConfiguration* Configuration::getFlagConfiguration(const std::string& key) const {
-    auto it = flags_.flags.find(key);
-    if (it == flags_.flags.end()) {
+const FlagConfiguration* Configuration::getFlagConfiguration(std::string_view key) const {
+    auto it = flagIndex_.find(key);
+    if (it == flagIndex_.end()) {
         return nullptr;
     }
-    return &(it->second);
+    return it->second;
 }
 
-const BanditConfiguration* Configuration::getBanditConfiguration(const std::string& key) const {
+const BanditConfiguration* Configuration::getBanditConfiguration(std::string_view key) const {
     auto it = bandits_.bandits.find(key);
     if (it == bandits_.bandits.end()) {
         return nullptr;
@@ -61,6 +185,46 @@ const BanditConfiguration* Configuration::getBanditConfiguration(const std::stri
     return &(it->second);
 }
 
+std::optional<size_t> Configuration::getAttributeId(const std::string& name) const {
+    auto it = attributeIds_.find(name);
+    if (it == attributeIds_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void Configuration::enableConditionStatistics() {
+    for (auto& [flagKey, flag] : flags_.flags) {
+        for (auto& allocation : flag.allocations) {
+            for (auto& rule : allocation.rules) {
+                for (auto& condition : rule.conditions) {
+                    if (!condition.statistics) {
+                        condition.statistics = std::make_shared<ConditionStatistics>();
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Configuration::reorderConditionsByStatistics() {
+    for (auto& [flagKey, flag] : flags_.flags) {
+        for (auto& allocation : flag.allocations) {
+            for (auto& rule : allocation.rules) {
+                rule.updateConditionOrder();
+            }
+        }
+    }
+}
+
+const AttributePatternSet* Configuration::getAttributePatternSet(size_t attributeId) const {
+    if (attributeId >= attributePatternSets_.size() ||
+        !attributePatternSets_[attributeId].patterns) {
+        return nullptr;
+    }
+    return &attributePatternSets_[attributeId];
+}
+
 ParseResult<Configuration> parseConfiguration(const std::string& flagConfigJson,
                                               const std::string& banditModelsJson) {
     ParseResult<Configuration> result;
@@ -1,13 +1,31 @@
 #ifndef CONFIGURATION_HPP
 #define CONFIGURATION_HPP
 
+#include <re2/set.h>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include "bandit_model.hpp"
 #include "config_response.hpp"
 #include "parse_result.hpp"
 
 namespace eppoclient {
 
+/**
+ * AttributePatternSet - the MATCHES/NOT_MATCHES patterns of every condition on
+ * one attribute compiled into a single RE2::Set, so a subject value is matched
+ * against all of them in one pass. A condition's patternSetIndex is the index of
+ * its pattern in the set.
+ */
+struct AttributePatternSet {
+    std::shared_ptr<const re2::RE2::Set> patterns;
+    size_t size = 0;
+};
+
 /**
  * Configuration holds the flag and bandit configuration data.
  * This is a stub implementation that will be expanded later.
@@ -20,10 +38,12 @@ public:
     ~Configuration() = default;
 
     // Copy constructor and assignment operator
-    Configuration(const Configuration& other) = default;
-    Configuration& operator=(const Configuration& other) = default;
+    // Rebuild the flag key index, which refers to the copied flags
+    Configuration(const Configuration& other);
+    Configuration& operator=(const Configuration& other);
 
     // Move constructor and assignment operator
+    // Moving keeps the flags' map nodes, so the flag key index stays valid
     Configuration(Configuration&& other) = default;
     Configuration& operator=(Configuration&& other) = default;
 
@@ -31,28 +51,86 @@ public:
      * Get bandit variation for a given flag key and variation value.
      * Returns true if found, false otherwise.
      */
-    bool getBanditVariant(const std::string& flagKey, const std::string& variation,
+    bool getBanditVariant(std::string_view flagKey, std::string_view variation,
                           BanditVariation& result) const;
 
     /**
      * Get flag configuration by key.
+     * Looking a key up does not copy it into a temporary std::string.
      * Returns nullptr if not found.
      */
-    const FlagConfiguration* getFlagConfiguration(const std::string& key) const;
+    const FlagConfiguration* getFlagConfiguration(std::string_view key) const;
 
     /**
      * Get bandit configuration by key.
      * Returns nullptr if not found.
      */
-    const BanditConfiguration* getBanditConfiguration(const std::string& key) const;
+    const BanditConfiguration* getBanditConfiguration(std::string_view key) const;
+
+    /**
+     * Get the dense attribute ID assigned to an attribute name referenced by
+     * flag conditions. IDs are assigned when the configuration is loaded.
+     * Returns std::nullopt if no condition references the attribute.
+     */
+    std::optional<size_t> getAttributeId(const std::string& name) const;
+
+    /**
+     * Get all attribute names referenced by flag conditions, indexed by attribute ID.
+     */
+    const std::vector<std::string>& getAttributeNames() const { return attributeNames_; }
+
+    /**
+     * Get the compiled pattern set for an attribute ID.
+     * Returns nullptr if fewer than two distinct patterns target the attribute.
+     */
+    const AttributePatternSet* getAttributePatternSet(size_t attributeId) const;
+
+    /**
+     * Start counting, for every condition, how often it is evaluated and how
+     * often it fails. Call before the configuration is used for evaluation.
+     * Counting adds two relaxed atomic increments per evaluated condition.
+     */
+    void enableConditionStatistics();
+
+    /**
+     * Reorder the conditions within each rule so that conditions that are
+     * cheap and observed to fail often are evaluated first. Which subjects
+     * match is unchanged. Copies of a configuration share its statistics, so
+     * this is typically applied to a copy of the configuration in use:
+     *
+     * @code
+     *   Configuration optimized = *store.getConfiguration();
+     *   optimized.reorderConditionsByStatistics();
+     *   store.setConfiguration(std::move(optimized));
+     * @endcode
+     */
+    void reorderConditionsByStatistics();
 
 private:
     ConfigResponse flags_;
     BanditResponse bandits_;
 
+    // Flag key -> flag configuration, keyed by views of the keys in flags_
+    // C++17 unordered_map has no heterogeneous lookup, so this index lets
+    // getFlagConfiguration() find a flag without constructing a std::string
+    std::unordered_map<std::string_view, const FlagConfiguration*> flagIndex_;
+
+    void buildFlagIndex();
+
+    // Attribute name -> dense ID for every attribute referenced by a condition
+    // Used by SubjectContext to resolve subject attributes once per subject
+    std::unordered_map<std::string, size_t> attributeIds_;
+    std::vector<std::string> attributeNames_;
+
+    // Attribute ID -> regex patterns of the attribute's MATCHES/NOT_MATCHES conditions
+    std::vector<AttributePatternSet> attributePatternSets_;
+
+    void buildAttributePatternSets();
+
     // Flag key -> variation value -> banditVariation
     // This is cached from bandits response for easier access in evaluation
-    std::map<std::string, std::map<std::string, BanditVariation>> banditFlagAssociations_;
+    std::map<std::string, std::map<std::string, BanditVariation, std::less<>>, std::less<>>
+        banditFlagAssociations_;
 };
 
 /**
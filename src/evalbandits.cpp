@@ -1,8 +1,13 @@
 #include "evalbandits.hpp"
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
 #include <vector>
+#include "bandit_scorer.hpp"
 #include "evalflags.hpp"
+#include "third_party/md5_wrapper.h"
 
 namespace eppoclient {
 
@@ -39,6 +44,21 @@ Attributes toGenericAttributes(const ContextAttributes& contextAttrs) {
     return result;
 }
 
+ContextAttributes BanditActionTable::actionAttributes(size_t row) const {
+    ContextAttributes attributes;
+    for (const auto& column : numericColumns) {
+        if (column.present == nullptr || column.present[row]) {
+            attributes.numericAttributes[std::string(column.attribute)] = column.values[row];
+        }
+    }
+    for (const auto& column : categoricalColumns) {
+        if (column.present == nullptr || column.present[row]) {
+            attributes.categoricalAttributes[std::string(column.attribute)] = column.values[row];
+        }
+    }
+    return attributes;
+}
+
 double scoreNumericAttributes(const std::vector<BanditNumericAttributeCoefficient>& coefficients,
                               const std::map<std::string, double>& attributes) {
     double score = 0.0;
@@ -95,110 +115,486 @@ double scoreAction(const BanditModelData& modelData, const ContextAttributes& su
     return score;
 }
 
-BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
-                                       const BanditEvaluationContext& context) {
-    const int64_t totalShards = 10000;
-    const size_t nActions = context.actions.size();
+namespace internal {
+
+void resolveBanditAttributes(const CompiledBanditModel::AttributeTable& numericAttributes,
+                             const CompiledBanditModel::AttributeTable& categoricalAttributes,
+                             const ContextAttributes& attributes,
+                             ResolvedBanditAttributes& resolved) {
+    resolved.numericValues.assign(numericAttributes.size(), 0.0);
+    resolved.numericPresent.assign(numericAttributes.size(), 0);
+    for (const auto& [key, value] : attributes.numericAttributes) {
+        auto it = numericAttributes.ids.find(key);
+        if (it != numericAttributes.ids.end()) {
+            resolved.numericValues[it->second] = value;
+            resolved.numericPresent[it->second] = 1;
+        }
+    }
 
-    // Score all actions
-    std::map<std::string, double> scores;
-    for (const auto& [actionKey, actionAttributes] : context.actions) {
-        scores[actionKey] =
-            scoreAction(modelData, context.subjectAttributes, actionKey, actionAttributes);
+    // Missing attributes and values without a coefficient get a slot past every value ID
+    resolved.categoricalSlots.resize(categoricalAttributes.size());
+    for (size_t id = 0; id < categoricalAttributes.size(); ++id) {
+        resolved.categoricalSlots[id] =
+            static_cast<uint32_t>(categoricalAttributes.valueIds[id].size());
+    }
+    for (const auto& [key, value] : attributes.categoricalAttributes) {
+        auto it = categoricalAttributes.ids.find(key);
+        if (it == categoricalAttributes.ids.end()) {
+            continue;
+        }
+        const auto& valueIds = categoricalAttributes.valueIds[it->second];
+        auto valueIt = valueIds.find(value);
+        if (valueIt != valueIds.end()) {
+            resolved.categoricalSlots[it->second] = valueIt->second;
+        }
     }
+}
+
+double scoreNumericTerms(const CompiledBanditModel::NumericTerms& terms,
+                         const ResolvedBanditAttributes& attributes) {
+    double score = 0.0;
+    for (size_t i = 0; i < terms.attributeIds.size(); ++i) {
+        uint32_t id = terms.attributeIds[i];
+        if (attributes.numericPresent[id]) {
+            score += terms.coefficients[i] * attributes.numericValues[id];
+        } else {
+            score += terms.missingValueCoefficients[i];
+        }
+    }
+    return score;
+}
+
+double scoreCategoricalTerms(const CompiledBanditModel::CategoricalTerms& terms,
+                             const ResolvedBanditAttributes& attributes) {
+    double score = 0.0;
+    for (size_t i = 0; i < terms.attributeIds.size(); ++i) {
+        score += terms.score(i, attributes.categoricalSlots[terms.attributeIds[i]]);
+    }
+    return score;
+}
+
+double scoreCompiledAction(const CompiledBanditModel::Action& action,
+                           const ResolvedBanditAttributes& subjectAttributes,
+                           const ResolvedBanditAttributes& actionAttributes) {
+    // Same summation order as scoreAction(), so scores are bit-identical
+    double score = action.intercept;
+    score += scoreNumericTerms(action.actionNumeric, actionAttributes);
+    score += scoreCategoricalTerms(action.actionCategorical, actionAttributes);
+    score += scoreNumericTerms(action.subjectNumeric, subjectAttributes);
+    score += scoreCategoricalTerms(action.subjectCategorical, subjectAttributes);
+    return score;
+}
+
+// Working state of evaluateBandit(), indexed by action position in the context.
+// Reusing it, evaluations allocate only when a context has more actions than any
+// before it.
+struct BanditScratch::State {
+    BanditActionScorer scorer;
+    std::vector<const std::string*> actionKeys;
+    std::vector<double> scores;
+    std::vector<double> weights;
+    std::vector<int64_t> shards;
+    std::vector<size_t> shuffledActions;
+
+    // Action map contexts: the entry of each action
+    std::vector<const std::pair<const std::string, ContextAttributes>*> actions;
+
+    // Columnar contexts: the table row of each action, the attribute ID of each
+    // column and the resolved attributes of the action being added
+    std::vector<size_t> rows;
+    std::vector<uint32_t> numericColumnIds;
+    std::vector<uint32_t> categoricalColumnIds;
+    ResolvedBanditAttributes actionAttributes;
+};
+
+BanditScratch::BanditScratch() : state_(std::make_unique<State>()) {}
+BanditScratch::~BanditScratch() = default;
+BanditScratch::BanditScratch(BanditScratch&&) noexcept = default;
+BanditScratch& BanditScratch::operator=(BanditScratch&&) noexcept = default;
+
+size_t BanditScratch::capacity() const {
+    return state_->actionKeys.capacity();
+}
+
+}  // namespace internal
 
-    // Find best action and best score
-    std::string bestAction;
+namespace {
+
+// Attribute ID of a column the model has no coefficients for
+constexpr uint32_t kUnknownAttribute = std::numeric_limits<uint32_t>::max();
+
+using ScratchState = internal::BanditScratch::State;
+
+// The scratch must be destroyed when its thread exits, or every thread that ever
+// evaluated a bandit would leak it, so the exit-time destructor is intended
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+ScratchState& threadScratch() {
+    thread_local internal::BanditScratch scratch;
+    return scratch.state();
+}
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+int64_t finalShard(md5_state state, std::string_view suffix, int64_t totalShards) {
+    unsigned char digest[MD5_DIGEST_LENGTH];
+    md5_update(&state, suffix.data(), suffix.size());
+    md5_final(&state, digest);
+    return internal::shardFromDigest(digest, totalShards);
+}
+
+BanditEvaluationDetails initialDetails(const BanditModelData& modelData, std::string_view flagKey,
+                                       std::string_view subjectKey,
+                                       const ContextAttributes& subjectAttributes) {
+    BanditEvaluationDetails details;
+    details.flagKey = std::string(flagKey);
+    details.subjectKey = std::string(subjectKey);
+    details.subjectAttributes = subjectAttributes;
+    details.gamma = modelData.gamma;
+    return details;
+}
+
+// Select one of the scored actions in scratch.actionKeys and set its score, weight
+// and optimality gap in details. Returns the index of the selected action.
+size_t selectBanditAction(const BanditModelData& modelData, std::string_view flagKey,
+                          std::string_view subjectKey, ScratchState& scratch,
+                          BanditEvaluationDetails& details) {
+    const int64_t totalShards = 10000;
+    const size_t nActions = scratch.actionKeys.size();
+    constexpr size_t kNoAction = static_cast<size_t>(-1);
+
+    const auto& actionKeys = scratch.actionKeys;
+    const auto& scores = scratch.scores;
+    auto& weights = scratch.weights;
+    auto& shards = scratch.shards;
+    auto& shuffledActions = scratch.shuffledActions;
+
+    // Find best action and best score; on ties the first action in key order wins
+    size_t best = kNoAction;
     double bestScore = -std::numeric_limits<double>::infinity();
-    for (const auto& [actionKey, score] : scores) {
-        if (score > bestScore || (score == bestScore && actionKey < bestAction)) {
-            bestAction = actionKey;
-            bestScore = score;
+    for (size_t i = 0; i < nActions; ++i) {
+        if (scores[i] > bestScore) {
+            best = i;
+            bestScore = scores[i];
         }
     }
+    // If no score exceeds -infinity, the best action keeps its initial empty key
+    if (best == kNoAction && actionKeys[0]->empty()) {
+        best = 0;
+    }
 
     // Calculate weights for each action
-    std::map<std::string, double> weights;
-    for (const auto& [actionKey, score] : scores) {
-        if (actionKey == bestAction) {
+    // Adjust probability floor for number of actions to control the sum
+    double minProbability = modelData.actionProbabilityFloor / static_cast<double>(nActions);
+    weights.assign(nActions, 0.0);
+    double remainderWeight = 1.0;
+    for (size_t i = 0; i < nActions; ++i) {
+        if (i == best) {
             // Best action weight is calculated as remainder
             continue;
         }
-
-        // Adjust probability floor for number of actions to control the sum
-        double minProbability = modelData.actionProbabilityFloor / static_cast<double>(nActions);
         double weight =
-            1.0 / (static_cast<double>(nActions) + modelData.gamma * (bestScore - score));
-        weights[actionKey] = std::max(minProbability, weight);
+            1.0 / (static_cast<double>(nActions) + modelData.gamma * (bestScore - scores[i]));
+        weights[i] = std::max(minProbability, weight);
+        remainderWeight -= weights[i];
+    }
+    if (best != kNoAction) {
+        weights[best] = std::max(0.0, remainderWeight);
     }
 
-    // Calculate remainder weight for best action
-    double remainderWeight = 1.0;
-    for (const auto& [_, weight] : weights) {
-        remainderWeight -= weight;
-    }
-    weights[bestAction] = std::max(0.0, remainderWeight);
-
-    // Pseudo-random deterministic shuffle of actions
-    std::vector<std::string> shuffledActions;
-    std::map<std::string, int64_t> shards;
-
-    for (const auto& [actionKey, _] : context.actions) {
-        shuffledActions.push_back(actionKey);
-        shards[actionKey] =
-            getShard(context.flagKey + "-" + context.subjectKey + "-" + actionKey, totalShards);
-    }
-
-    // Sort actions by their shard value, using action key as tie breaker
-    std::sort(shuffledActions.begin(), shuffledActions.end(),
-              [&shards](const std::string& a1, const std::string& a2) {
-                  int64_t v1 = shards[a1];
-                  int64_t v2 = shards[a2];
-                  if (v1 < v2) {
-                      return true;
-                  } else if (v1 > v2) {
-                      return false;
-                  } else {
-                      // Tie-breaking
-                      return a1 < a2;
-                  }
-              });
+    // Pseudo-random deterministic shuffle of actions. The MD5 state after the
+    // shared "flagKey-subjectKey" prefix is computed once and copied per action.
+    md5_state subjectState;
+    md5_init(&subjectState);
+    md5_update(&subjectState, flagKey.data(), flagKey.size());
+    md5_update(&subjectState, "-", 1);
+    md5_update(&subjectState, subjectKey.data(), subjectKey.size());
+    md5_state actionPrefixState = subjectState;
+    md5_update(&actionPrefixState, "-", 1);
+
+    shards.resize(nActions);
+    shuffledActions.resize(nActions);
+    for (size_t i = 0; i < nActions; ++i) {
+        shards[i] = finalShard(actionPrefixState, *actionKeys[i], totalShards);
+        shuffledActions[i] = i;
+    }
+
+    // Sort actions by their shard value; actions are indexed in key order, so
+    // comparing indices breaks ties by action key
+    std::sort(shuffledActions.begin(), shuffledActions.end(), [&shards](size_t a1, size_t a2) {
+        return shards[a1] != shards[a2] ? shards[a1] < shards[a2] : a1 < a2;
+    });
 
     // Select action based on shard value
-    double shardValue =
-        static_cast<double>(getShard(context.flagKey + "-" + context.subjectKey, totalShards)) /
-        static_cast<double>(totalShards);
+    double shardValue = static_cast<double>(finalShard(subjectState, "", totalShards)) /
+                        static_cast<double>(totalShards);
 
     double cumulativeWeight = 0.0;
-    std::string selectedAction = shuffledActions.back();  // Default to last action
-    for (const auto& actionKey : shuffledActions) {
-        cumulativeWeight += weights[actionKey];
+    size_t selected = shuffledActions.back();  // Default to last action
+    for (size_t i : shuffledActions) {
+        cumulativeWeight += weights[i];
         if (cumulativeWeight > shardValue) {
-            selectedAction = actionKey;
+            selected = i;
             break;
         }
     }
 
-    double optimalityGap = bestScore - scores[selectedAction];
+    details.actionScore = scores[selected];
+    details.actionWeight = weights[selected];
+    details.optimalityGap = bestScore - scores[selected];
+    return selected;
+}
 
-    BanditEvaluationDetails details;
-    details.flagKey = context.flagKey;
-    details.subjectKey = context.subjectKey;
-    details.subjectAttributes = context.subjectAttributes;
-    details.actionKey = selectedAction;
-    details.actionAttributes = context.actions.at(selectedAction);
-    details.actionScore = scores[selectedAction];
-    details.actionWeight = weights[selectedAction];
-    details.gamma = modelData.gamma;
-    details.optimalityGap = optimalityGap;
+uint32_t columnAttributeId(const CompiledBanditModel::AttributeTable& attributes,
+                           std::string_view attribute) {
+    auto it = attributes.ids.find(std::string(attribute));
+    return it != attributes.ids.end() ? it->second : kUnknownAttribute;
+}
+
+// Resolve the attributes of a row of an action table, given the attribute ID of
+// each of its columns
+void resolveActionRow(const CompiledBanditModel& model, const BanditActionTable& table,
+                      size_t row, const std::vector<uint32_t>& numericColumnIds,
+                      const std::vector<uint32_t>& categoricalColumnIds,
+                      internal::ResolvedBanditAttributes& resolved) {
+    const auto& numericAttributes = model.actionNumericAttributes;
+    resolved.numericValues.assign(numericAttributes.size(), 0.0);
+    resolved.numericPresent.assign(numericAttributes.size(), 0);
+    for (size_t i = 0; i < table.numericColumns.size(); ++i) {
+        const auto& column = table.numericColumns[i];
+        uint32_t id = numericColumnIds[i];
+        if (id != kUnknownAttribute && (column.present == nullptr || column.present[row])) {
+            resolved.numericValues[id] = column.values[row];
+            resolved.numericPresent[id] = 1;
+        }
+    }
+
+    // Missing attributes and values without a coefficient get a slot past every value ID
+    const auto& categoricalAttributes = model.actionCategoricalAttributes;
+    resolved.categoricalSlots.resize(categoricalAttributes.size());
+    for (size_t id = 0; id < categoricalAttributes.size(); ++id) {
+        resolved.categoricalSlots[id] =
+            static_cast<uint32_t>(categoricalAttributes.valueIds[id].size());
+    }
+    for (size_t i = 0; i < table.categoricalColumns.size(); ++i) {
+        const auto& column = table.categoricalColumns[i];
+        uint32_t id = categoricalColumnIds[i];
+        if (id == kUnknownAttribute || (column.present != nullptr && !column.present[row])) {
+            continue;
+        }
+        const auto& valueIds = categoricalAttributes.valueIds[id];
+        auto valueIt = valueIds.find(column.values[row]);
+        if (valueIt != valueIds.end()) {
+            resolved.categoricalSlots[id] = valueIt->second;
+        }
+    }
+}
+
+// Copy the scores and weights of the evaluated actions to distribution, and rank
+// the topK highest-scoring ones
+void fillDistribution(const ScratchState& scratch, size_t topK,
+                      BanditActionDistribution& distribution) {
+    const size_t nActions = scratch.actionKeys.size();
+    distribution.actionKeys.clear();
+    for (const std::string* actionKey : scratch.actionKeys) {
+        distribution.actionKeys.emplace_back(*actionKey);
+    }
+    distribution.scores = scratch.scores;
+    distribution.weights = scratch.weights;
+
+    // Highest score first; on ties the first action in key order
+    auto& topActions = distribution.topActions;
+    const auto& scores = distribution.scores;
+    topActions.resize(nActions);
+    for (size_t i = 0; i < nActions; ++i) {
+        topActions[i] = i;
+    }
+    auto middle = topActions.begin() + static_cast<std::ptrdiff_t>(std::min(topK, nActions));
+    std::partial_sort(topActions.begin(), middle, topActions.end(),
+                      [&scores](size_t a1, size_t a2) {
+                          return scores[a1] != scores[a2] ? scores[a1] > scores[a2] : a1 < a2;
+                      });
+    topActions.erase(middle, topActions.end());
+}
+
+BanditEvaluationDetails evaluateActions(const BanditModelData& modelData,
+                                        const BanditEvaluationContext& context,
+                                        BanditActionDistribution* distribution, size_t topK,
+                                        ScratchState& scratch) {
+    BanditEvaluationDetails details = initialDetails(modelData, context.flagKey,
+                                                     context.subjectKey, context.subjectAttributes);
+    if (context.actions.empty()) {
+        if (distribution != nullptr) {
+            *distribution = BanditActionDistribution();
+        }
+        return details;
+    }
+
+    auto& actions = scratch.actions;
+    auto& scores = scratch.scores;
+
+    // Actions are indexed in key order
+    actions.clear();
+    scratch.actionKeys.clear();
+    for (const auto& action : context.actions) {
+        actions.push_back(&action);
+        scratch.actionKeys.push_back(&action.first);
+    }
+
+    // Score all actions, at once if the model is compiled
+    const CompiledBanditModel& model = modelData.compiledModel;
+    if (model.valid) {
+        scratch.scorer.reset(model, context.subjectAttributes);
+        for (const auto* action : actions) {
+            scratch.scorer.addAction(action->first, action->second);
+        }
+        scratch.scorer.score(modelData.defaultActionScore, scores);
+    } else {
+        scores.clear();
+        for (const auto* action : actions) {
+            scores.push_back(
+                scoreAction(modelData, context.subjectAttributes, action->first, action->second));
+        }
+    }
+
+    size_t selected =
+        selectBanditAction(modelData, context.flagKey, context.subjectKey, scratch, details);
+    details.actionKey = actions[selected]->first;
+    details.actionAttributes = actions[selected]->second;
+    if (distribution != nullptr) {
+        fillDistribution(scratch, topK, *distribution);
+    }
 
     return details;
 }
 
-BanditEvent createBanditEvent(const std::string& flagKey, const std::string& subjectKey,
-                              const std::string& banditKey, const std::string& modelVersion,
-                              const BanditEvaluationDetails& evaluation,
-                              const std::string& timestamp) {
+BanditEvaluationDetails evaluateActions(const BanditModelData& modelData,
+                                        const BanditColumnarEvaluationContext& context,
+                                        BanditActionDistribution* distribution, size_t topK,
+                                        ScratchState& scratch) {
+    const BanditActionTable& table = context.actions;
+    BanditEvaluationDetails details = initialDetails(modelData, context.flagKey,
+                                                     context.subjectKey, context.subjectAttributes);
+    if (table.empty()) {
+        if (distribution != nullptr) {
+            *distribution = BanditActionDistribution();
+        }
+        return details;
+    }
+
+    auto& rows = scratch.rows;
+    auto& scores = scratch.scores;
+
+    // Actions are indexed in key order, as in an action map; of rows with the
+    // same key, the first is kept
+    rows.resize(table.actionCount);
+    for (size_t row = 0; row < table.actionCount; ++row) {
+        rows[row] = row;
+    }
+    std::stable_sort(rows.begin(), rows.end(), [&table](size_t r1, size_t r2) {
+        return table.actionKeys[r1] < table.actionKeys[r2];
+    });
+    rows.erase(std::unique(rows.begin(), rows.end(),
+                           [&table](size_t r1, size_t r2) {
+                               return table.actionKeys[r1] == table.actionKeys[r2];
+                           }),
+               rows.end());
+    scratch.actionKeys.clear();
+    for (size_t row : rows) {
+        scratch.actionKeys.push_back(&table.actionKeys[row]);
+    }
+
+    // Score all actions, at once if the model is compiled. Column attributes are
+    // resolved to attribute IDs once per table rather than once per action.
+    const CompiledBanditModel& model = modelData.compiledModel;
+    if (model.valid) {
+        scratch.numericColumnIds.clear();
+        for (const auto& column : table.numericColumns) {
+            scratch.numericColumnIds.push_back(
+                columnAttributeId(model.actionNumericAttributes, column.attribute));
+        }
+        scratch.categoricalColumnIds.clear();
+        for (const auto& column : table.categoricalColumns) {
+            scratch.categoricalColumnIds.push_back(
+                columnAttributeId(model.actionCategoricalAttributes, column.attribute));
+        }
+
+        scratch.scorer.reset(model, context.subjectAttributes);
+        for (size_t row : rows) {
+            resolveActionRow(model, table, row, scratch.numericColumnIds,
+                             scratch.categoricalColumnIds, scratch.actionAttributes);
+            scratch.scorer.addAction(table.actionKeys[row], scratch.actionAttributes);
+        }
+        scratch.scorer.score(modelData.defaultActionScore, scores);
+    } else {
+        scores.clear();
+        for (size_t row : rows) {
+            scores.push_back(scoreAction(modelData, context.subjectAttributes,
+                                         table.actionKeys[row], table.actionAttributes(row)));
+        }
+    }
+
+    size_t selected =
+        selectBanditAction(modelData, context.flagKey, context.subjectKey, scratch, details);
+    details.actionKey = table.actionKeys[rows[selected]];
+    details.actionAttributes = table.actionAttributes(rows[selected]);
+    if (distribution != nullptr) {
+        fillDistribution(scratch, topK, *distribution);
+    }
+
+    return details;
+}
+
+}  // namespace
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditEvaluationContext& context) {
+    return evaluateActions(modelData, context, nullptr, 0, threadScratch());
+}
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditColumnarEvaluationContext& context) {
+    return evaluateActions(modelData, context, nullptr, 0, threadScratch());
+}
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditEvaluationContext& context, size_t topK,
+                                       BanditActionDistribution& distribution) {
+    return evaluateActions(modelData, context, &distribution, topK, threadScratch());
+}
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditColumnarEvaluationContext& context,
+                                       size_t topK, BanditActionDistribution& distribution) {
+    return evaluateActions(modelData, context, &distribution, topK, threadScratch());
+}
+
+namespace internal {
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditEvaluationContext& context,
+                                       BanditScratch& scratch) {
+    return evaluateActions(modelData, context, nullptr, 0, scratch.state());
+}
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditColumnarEvaluationContext& context,
+                                       BanditScratch& scratch) {
+    return evaluateActions(modelData, context, nullptr, 0, scratch.state());
+}
+
+}  // namespace internal
+
+namespace {
+
+// Create a BanditEvent with everything but the subject and action attributes
+BanditEvent createBanditEventHeader(const std::string& flagKey, const std::string& subjectKey,
+                                    const std::string& banditKey, const std::string& modelVersion,
+                                    const BanditEvaluationDetails& evaluation,
+                                    const std::string& timestamp) {
     BanditEvent event;
     event.flagKey = flagKey;
     event.banditKey = banditKey;
@@ -208,12 +604,37 @@ BanditEvent createBanditEvent(const std::string& flagKey, const std::string& sub
     event.optimalityGap = evaluation.optimalityGap;
     event.modelVersion = modelVersion;
     event.timestamp = timestamp;
+    event.metaData["sdkLanguage"] = "cpp";
+    event.metaData["sdkVersion"] = SDK_VERSION;
+    return event;
+}
+
+}  // namespace
+
+BanditEvent createBanditEvent(const std::string& flagKey, const std::string& subjectKey,
+                              const std::string& banditKey, const std::string& modelVersion,
+                              const BanditEvaluationDetails& evaluation,
+                              const std::string& timestamp) {
+    BanditEvent event = createBanditEventHeader(flagKey, subjectKey, banditKey, modelVersion,
+                                                evaluation, timestamp);
     event.subjectNumericAttributes = evaluation.subjectAttributes.numericAttributes;
     event.subjectCategoricalAttributes = evaluation.subjectAttributes.categoricalAttributes;
     event.actionNumericAttributes = evaluation.actionAttributes.numericAttributes;
     event.actionCategoricalAttributes = evaluation.actionAttributes.categoricalAttributes;
-    event.metaData["sdkLanguage"] = "cpp";
-    event.metaData["sdkVersion"] = SDK_VERSION;
+    return event;
+}
+
+BanditEvent createBanditEvent(const std::string& flagKey, const std::string& subjectKey,
+                              const std::string& banditKey, const std::string& modelVersion,
+                              BanditEvaluationDetails&& evaluation, const std::string& timestamp) {
+    BanditEvent event = createBanditEventHeader(flagKey, subjectKey, banditKey, modelVersion,
+                                                evaluation, timestamp);
+    event.subjectNumericAttributes = std::move(evaluation.subjectAttributes.numericAttributes);
+    event.subjectCategoricalAttributes =
+        std::move(evaluation.subjectAttributes.categoricalAttributes);
+    event.actionNumericAttributes = std::move(evaluation.actionAttributes.numericAttributes);
+    event.actionCategoricalAttributes =
+        std::move(evaluation.actionAttributes.categoricalAttributes);
     return event;
 }
 
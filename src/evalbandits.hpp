@@ -1,9 +1,14 @@
 #ifndef EVALBANDITS_HPP
 #define EVALBANDITS_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "bandit_model.hpp"
 #include "rules.hpp"
 
@@ -20,6 +25,51 @@ struct ContextAttributes {
     ContextAttributes() = default;
 };
 
+/**
+ * One attribute column of a BanditActionTable.
+ * Holds one value per action, in the table's row order. If present is set, an
+ * action has a value only where present is nonzero; otherwise every action has one.
+ */
+template <typename T>
+struct BanditActionColumn {
+    std::string_view attribute;
+    const T* values = nullptr;
+    const uint8_t* present = nullptr;
+};
+
+/**
+ * Candidate actions for bandit evaluation, in columnar form.
+ *
+ * Row i is the action actionKeys[i], whose attributes are the i-th values of the
+ * numeric and categorical columns. Action keys and column attributes must be
+ * unique. The table refers to the caller's arrays instead of copying them, so
+ * they must outlive it.
+ *
+ * Example usage:
+ * @code
+ * std::vector<std::string> keys = {"nike", "adidas"};
+ * std::vector<double> prices = {120.0, 35.0};
+ * std::vector<std::string> categories = {"shoes", "hats"};
+ *
+ * eppoclient::BanditActionTable actions;
+ * actions.actionKeys = keys.data();
+ * actions.actionCount = keys.size();
+ * actions.numericColumns.push_back({"price", prices.data()});
+ * actions.categoricalColumns.push_back({"category", categories.data()});
+ * @endcode
+ */
+struct BanditActionTable {
+    const std::string* actionKeys = nullptr;
+    size_t actionCount = 0;
+    std::vector<BanditActionColumn<double>> numericColumns;
+    std::vector<BanditActionColumn<std::string>> categoricalColumns;
+
+    bool empty() const { return actionCount == 0; }
+
+    // Get the attributes of the action in a row
+    ContextAttributes actionAttributes(size_t row) const;
+};
+
 /**
  * Result of a bandit action evaluation.
  */
@@ -67,12 +117,41 @@ Attributes toGenericAttributes(const ContextAttributes& contextAttrs);
 
 /**
  * Internal context for bandit evaluation.
+ * Refers to the caller's keys, subject attributes and actions instead of copying
+ * them, so they must outlive the context.
  */
 struct BanditEvaluationContext {
-    std::string flagKey;
-    std::string subjectKey;
-    ContextAttributes subjectAttributes;
-    std::map<std::string, ContextAttributes> actions;
+    std::string_view flagKey;
+    std::string_view subjectKey;
+    const ContextAttributes& subjectAttributes;
+    const std::map<std::string, ContextAttributes>& actions;
+
+    BanditEvaluationContext(std::string_view flagKey, std::string_view subjectKey,
+                            const ContextAttributes& subjectAttributes,
+                            const std::map<std::string, ContextAttributes>& actions)
+        : flagKey(flagKey),
+          subjectKey(subjectKey),
+          subjectAttributes(subjectAttributes),
+          actions(actions) {}
+};
+
+/**
+ * Internal context for bandit evaluation over a columnar action table.
+ * Like BanditEvaluationContext, it refers to the caller's data.
+ */
+struct BanditColumnarEvaluationContext {
+    std::string_view flagKey;
+    std::string_view subjectKey;
+    const ContextAttributes& subjectAttributes;
+    const BanditActionTable& actions;
+
+    BanditColumnarEvaluationContext(std::string_view flagKey, std::string_view subjectKey,
+                                    const ContextAttributes& subjectAttributes,
+                                    const BanditActionTable& actions)
+        : flagKey(flagKey),
+          subjectKey(subjectKey),
+          subjectAttributes(subjectAttributes),
+          actions(actions) {}
 };
 
 /**
@@ -93,6 +172,20 @@ struct BanditEvaluationDetails {
         : actionScore(0.0), actionWeight(0.0), gamma(0.0), optimalityGap(0.0) {}
 };
 
+/**
+ * Scores and selection probabilities of every action of a bandit evaluation.
+ *
+ * Actions are indexed in key order. actionKeys refer to the keys of the evaluated
+ * context's actions and are valid as long as those are. Reusing a distribution
+ * across evaluations reuses its buffers.
+ */
+struct BanditActionDistribution {
+    std::vector<std::string_view> actionKeys;
+    std::vector<double> scores;
+    std::vector<double> weights;     // Probability of selecting each action
+    std::vector<size_t> topActions;  // Highest-scoring actions, best first; ties in key order
+};
+
 /**
  * Evaluates a bandit model to select the best action.
  * Implements the contextual bandit algorithm with Thompson sampling.
@@ -100,6 +193,28 @@ struct BanditEvaluationDetails {
 BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
                                        const BanditEvaluationContext& context);
 
+/**
+ * Evaluates a bandit model over a columnar action table.
+ * Selects the same action as evaluateBandit() over the equivalent action map,
+ * without building per-action attribute maps when the model is compiled.
+ */
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditColumnarEvaluationContext& context);
+
+/**
+ * Evaluates a bandit model like evaluateBandit(), and also sets the score and
+ * weight of every action in distribution, along with the topK highest-scoring
+ * actions. Callers ranking a slate need not re-score the actions.
+ */
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditEvaluationContext& context, size_t topK,
+                                       BanditActionDistribution& distribution);
+
+// Evaluates a bandit model over a columnar action table, with the action distribution
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditColumnarEvaluationContext& context,
+                                       size_t topK, BanditActionDistribution& distribution);
+
 /**
  * Scores a single action using the bandit model coefficients.
  */
@@ -133,6 +248,84 @@ BanditEvent createBanditEvent(const std::string& flagKey, const std::string& sub
                               const BanditEvaluationDetails& evaluation,
                               const std::string& timestamp);
 
+/**
+ * Creates a BanditEvent from evaluation results that are no longer needed,
+ * moving their subject and action attributes into the event instead of copying them.
+ */
+BanditEvent createBanditEvent(const std::string& flagKey, const std::string& subjectKey,
+                              const std::string& banditKey, const std::string& modelVersion,
+                              BanditEvaluationDetails&& evaluation, const std::string& timestamp);
+
+// Internal namespace for implementation details not covered by semver
+namespace internal {
+
+// A context's attributes resolved against the attribute tables of a compiled bandit model
+struct ResolvedBanditAttributes {
+    std::vector<double> numericValues;       // Indexed by numeric attribute ID
+    std::vector<uint8_t> numericPresent;     // Indexed by numeric attribute ID
+    std::vector<uint32_t> categoricalSlots;  // Indexed by categorical attribute ID
+};
+
+// Resolve attributes against the numeric and categorical attribute tables of one
+// kind (subject or action) of a compiled bandit model
+void resolveBanditAttributes(const CompiledBanditModel::AttributeTable& numericAttributes,
+                             const CompiledBanditModel::AttributeTable& categoricalAttributes,
+                             const ContextAttributes& attributes,
+                             ResolvedBanditAttributes& resolved);
+
+// Sum the numeric terms of one kind of a compiled action; identical to scoreNumericAttributes()
+double scoreNumericTerms(const CompiledBanditModel::NumericTerms& terms,
+                         const ResolvedBanditAttributes& attributes);
+
+// Sum the categorical terms of one kind of a compiled action; identical to
+// scoreCategoricalAttributes()
+double scoreCategoricalTerms(const CompiledBanditModel::CategoricalTerms& terms,
+                             const ResolvedBanditAttributes& attributes);
+
+// Score a compiled action; the result is identical to scoreAction()
+double scoreCompiledAction(const CompiledBanditModel::Action& action,
+                           const ResolvedBanditAttributes& subjectAttributes,
+                           const ResolvedBanditAttributes& actionAttributes);
+
+/**
+ * BanditScratch - working state of bandit evaluations, reused across them
+ *
+ * evaluateBandit() keeps one scratch per thread. Callers evaluating many contexts
+ * on threads they start themselves, such as batch evaluation, own a scratch per
+ * worker instead, so the state is reused across their evaluations and freed with
+ * the scratch rather than living as long as the thread.
+ *
+ * A scratch must not be used by multiple threads at once.
+ */
+class BanditScratch {
+public:
+    struct State;
+
+    BanditScratch();
+    ~BanditScratch();
+    BanditScratch(BanditScratch&&) noexcept;
+    BanditScratch& operator=(BanditScratch&&) noexcept;
+
+    // Number of actions the scratch can evaluate without allocating
+    size_t capacity() const;
+
+    State& state() { return *state_; }
+
+private:
+    std::unique_ptr<State> state_;
+};
+
+// Evaluate a bandit model like evaluateBandit(), with the given scratch state
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditEvaluationContext& context,
+                                       BanditScratch& scratch);
+
+BanditEvaluationDetails evaluateBandit(const BanditModelData& modelData,
+                                       const BanditColumnarEvaluationContext& context,
+                                       BanditScratch& scratch);
+
+}  // namespace internal
+
 }  // namespace eppoclient
 
 #endif  // EVALBANDITS_H
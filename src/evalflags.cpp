@@ -1,4 +1,6 @@
 #include "evalflags.hpp"
+#include <algorithm>
+#include <utility>
 #include "third_party/md5_wrapper.h"
 #include "time_utils.hpp"
 #include "version.hpp"
@@ -13,152 +15,250 @@ bool verifyType(const FlagConfiguration& flag, VariationType expectedType) {
     return flag.variationType == expectedType;
 }
 
-// Evaluate a flag for a given subject
-// Returns std::nullopt if evaluation fails
-std::optional<EvalResult> evalFlag(const FlagConfiguration& flag, const std::string& subjectKey,
-                                   const Attributes& subjectAttributes, ApplicationLogger* logger) {
-    // Check if flag is enabled
-    if (!flag.enabled) {
-        if (logger) {
-            logger->info("Flag is not enabled: " + flag.key);
-        }
+namespace {
+
+// Trace policies for the evaluation core. Each policy is a separate
+// instantiation, so evaluation without details contains no tracing code.
+struct NoTrace {
+    static constexpr bool kAllocations = false;
+    static constexpr bool kRulesAndSplits = false;
+};
+
+struct AllocationTrace {
+    static constexpr bool kAllocations = true;
+    static constexpr bool kRulesAndSplits = false;
+};
+
+struct FullTrace {
+    static constexpr bool kAllocations = true;
+    static constexpr bool kRulesAndSplits = true;
+};
+
+// Convert a subject attribute to the value recorded in condition details
+std::optional<std::variant<std::string, int64_t, double, bool>> traceAttributeValue(
+    const AttributeValue* value) {
+    if (value == nullptr) {
         return std::nullopt;
     }
-
-    auto now = std::chrono::system_clock::now();
-    Attributes augmentedSubjectAttributes = augmentWithSubjectKey(subjectAttributes, subjectKey);
-
-    // Find matching allocation and split
-    const Allocation* matchedAllocation = nullptr;
-    const Split* matchedSplit = nullptr;
-
-    for (const auto& allocation : flag.allocations) {
-        const Split* split = findMatchingSplit(allocation, subjectKey, augmentedSubjectAttributes,
-                                               flag.totalShards, now, logger);
-        if (split != nullptr) {
-            matchedAllocation = &allocation;
-            matchedSplit = split;
-            break;
-        }
+    if (std::holds_alternative<std::string>(*value)) {
+        return std::get<std::string>(*value);
+    } else if (std::holds_alternative<int64_t>(*value)) {
+        return std::get<int64_t>(*value);
+    } else if (std::holds_alternative<double>(*value)) {
+        return std::get<double>(*value);
+    } else if (std::holds_alternative<bool>(*value)) {
+        return std::get<bool>(*value);
     }
+    return std::nullopt;
+}
 
-    if (matchedAllocation == nullptr || matchedSplit == nullptr) {
-        if (logger) {
-            logger->info("Subject is not part of any allocation");
+// Evaluate rules in configuration order until one matches, recording every
+// condition of each evaluated rule
+bool traceRules(const Allocation& allocation, const SubjectContext& subject,
+                ApplicationLogger* logger, std::vector<RuleEvaluationDetails>& evaluatedRules) {
+    for (const auto& rule : allocation.rules) {
+        RuleEvaluationDetails ruleDetails;
+        ruleDetails.matched = true;
+        for (const auto& condition : rule.conditions) {
+            ConditionEvaluationDetails conditionDetails;
+            conditionDetails.condition = condition;
+            conditionDetails.attributeValue = traceAttributeValue(subject.getAttribute(condition));
+            conditionDetails.matched = internal::conditionMatches(condition, subject, logger);
+            ruleDetails.matched = ruleDetails.matched && conditionDetails.matched;
+            ruleDetails.conditions.push_back(std::move(conditionDetails));
         }
-        return std::nullopt;
-    }
 
-    // Find the variation value
-    auto it = flag.parsedVariations.find(matchedSplit->variationKey);
-    if (it == flag.parsedVariations.end()) {
-        if (logger) {
-            logger->error("Cannot find variation: " + matchedSplit->variationKey);
+        bool matched = ruleDetails.matched;
+        evaluatedRules.push_back(std::move(ruleDetails));
+        if (matched) {
+            return true;
         }
-        return std::nullopt;
-    }
-
-    EvalResult result;
-    result.value = it->second;
-
-    // Create assignment event if logging is enabled
-    bool shouldLog = true;
-    if (matchedAllocation->doLog.has_value()) {
-        shouldLog = matchedAllocation->doLog.value();
     }
+    return false;
+}
 
-    if (shouldLog) {
-        AssignmentEvent event;
-        event.featureFlag = flag.key;
-        event.allocation = matchedAllocation->key;
-        event.experiment = flag.key + "-" + matchedAllocation->key;
-        event.variation = matchedSplit->variationKey;
-        event.subject = subjectKey;
-        event.subjectAttributes = subjectAttributes;
-        event.timestamp = formatISOTimestamp(now);
-        event.metaData = {{"sdkLanguage", "cpp"}, {"sdkVersion", SDK_VERSION}};
-
-        // Convert extraLogging JSON to map of strings
-        if (matchedSplit->extraLogging.is_object()) {
-            for (auto& [key, value] : matchedSplit->extraLogging.items()) {
-                if (value.is_string()) {
-                    event.extraLogging[key] = value.get<std::string>();
-                } else {
-                    event.extraLogging[key] = value.dump();
+// Evaluate splits in order until one matches, recording every shard of each
+// evaluated split
+const Split* traceSplits(const Allocation& allocation, const std::string& subjectKey,
+                         int64_t totalShards,
+                         std::vector<SplitEvaluationDetails>& evaluatedSplits) {
+    for (const auto& split : allocation.splits) {
+        SplitEvaluationDetails splitDetails;
+        splitDetails.variationKey = split.variationKey;
+        splitDetails.matched = true;
+        for (const auto& shard : split.shards) {
+            int64_t shardValue = getShard(shard.salt + "-" + subjectKey, totalShards);
+
+            ShardEvaluationDetails shardDetails;
+            shardDetails.shard = shard;
+            shardDetails.shardValue = static_cast<uint32_t>(shardValue);
+            shardDetails.matched = false;
+            for (const auto& range : shard.ranges) {
+                if (isShardInRange(shardValue, range)) {
+                    shardDetails.matched = true;
+                    break;
                 }
             }
+            splitDetails.matched = splitDetails.matched && shardDetails.matched;
+            splitDetails.shards.push_back(std::move(shardDetails));
         }
 
-        result.event = event;
+        bool matched = splitDetails.matched;
+        evaluatedSplits.push_back(std::move(splitDetails));
+        if (matched) {
+            return &split;
+        }
     }
-
-    return result;
+    return nullptr;
 }
 
-// Helper function to evaluate allocation with details
-AllocationEvaluationDetails evaluateAllocationWithDetails(
-    const Allocation& allocation, const std::string& subjectKey,
-    const Attributes& augmentedSubjectAttributes, int64_t totalShards,
-    const std::chrono::system_clock::time_point& now, size_t orderPosition,
-    ApplicationLogger* logger) {
-    AllocationEvaluationDetails details;
-    details.key = allocation.key;
-    details.orderPosition = orderPosition;
+// Evaluate one allocation for the subject
+// Sets matchedSplit to the matching split when the allocation matches, nullptr otherwise.
+// details is only written when the policy traces rules and splits.
+template <typename Trace>
+AllocationEvaluationCode evaluateAllocation(const Allocation& allocation,
+                                            const SubjectContext& subject, int64_t totalShards,
+                                            const std::chrono::system_clock::time_point& now,
+                                            ApplicationLogger* logger, const Split*& matchedSplit,
+                                            AllocationEvaluationDetails* details) {
+    matchedSplit = nullptr;
 
     // Check time constraints
     if (allocation.startAt.has_value() && now < allocation.startAt.value()) {
-        details.allocationEvaluationCode = AllocationEvaluationCode::BEFORE_START_TIME;
-        return details;
+        return AllocationEvaluationCode::BEFORE_START_TIME;
     }
     if (allocation.endAt.has_value() && now > allocation.endAt.value()) {
-        details.allocationEvaluationCode = AllocationEvaluationCode::AFTER_END_TIME;
-        return details;
+        return AllocationEvaluationCode::AFTER_END_TIME;
     }
 
     // Check if any rule matches
-    bool matchesRule = false;
     if (!allocation.rules.empty()) {
-        for (const auto& rule : allocation.rules) {
-            if (internal::ruleMatches(rule, augmentedSubjectAttributes, logger)) {
-                matchesRule = true;
-                break;
-            }
+        bool matchesRule;
+        if constexpr (Trace::kRulesAndSplits) {
+            matchesRule = traceRules(allocation, subject, logger, details->evaluatedRules);
+        } else {
+            matchesRule =
+                internal::anyRuleMatches(allocation.rules, allocation.ruleOrder, subject, logger);
         }
         if (!matchesRule) {
-            details.allocationEvaluationCode = AllocationEvaluationCode::FAILING_RULE;
-            return details;
+            return AllocationEvaluationCode::FAILING_RULE;
         }
     }
 
     // Find matching split
-    bool foundMatchingSplit = false;
-    for (const auto& split : allocation.splits) {
-        if (splitMatches(split, subjectKey, totalShards)) {
-            foundMatchingSplit = true;
-            break;
+    if constexpr (Trace::kRulesAndSplits) {
+        matchedSplit = traceSplits(allocation, subject.getSubjectKey(), totalShards,
+                                   details->evaluatedSplits);
+    } else {
+        (void)details;
+        matchedSplit = selectSplit(allocation, subject.getSubjectKey(), totalShards);
+    }
+    if (matchedSplit == nullptr) {
+        return AllocationEvaluationCode::TRAFFIC_EXPOSURE_MISS;
+    }
+
+    return AllocationEvaluationCode::MATCH;
+}
+
+// Evaluate allocations in order until one matches
+// When the policy traces allocations, every allocation is recorded in allocationDetails,
+// with the ones after the match marked UNEVALUATED
+template <typename Trace>
+void evaluateAllocations(const FlagConfiguration& flag, const SubjectContext& subject,
+                         const std::chrono::system_clock::time_point& now,
+                         ApplicationLogger* logger, const Allocation*& matchedAllocation,
+                         const Split*& matchedSplit,
+                         std::vector<AllocationEvaluationDetails>* allocationDetails) {
+    matchedAllocation = nullptr;
+    matchedSplit = nullptr;
+    if constexpr (Trace::kAllocations) {
+        allocationDetails->reserve(flag.allocations.size());
+    } else {
+        (void)allocationDetails;
+    }
+
+    for (size_t i = 0; i < flag.allocations.size(); ++i) {
+        const auto& allocation = flag.allocations[i];
+
+        if constexpr (Trace::kAllocations) {
+            AllocationEvaluationDetails details;
+            details.key = allocation.key;
+            details.orderPosition = i + 1;  // 1-indexed to match shared test data
+
+            // If we already found a match, mark remaining allocations as UNEVALUATED
+            if (matchedAllocation != nullptr) {
+                details.allocationEvaluationCode = AllocationEvaluationCode::UNEVALUATED;
+            } else {
+                const Split* split = nullptr;
+                details.allocationEvaluationCode = evaluateAllocation<Trace>(
+                    allocation, subject, flag.totalShards, now, logger, split, &details);
+                if (details.allocationEvaluationCode == AllocationEvaluationCode::MATCH) {
+                    matchedAllocation = &allocation;
+                    matchedSplit = split;
+                }
+            }
+            allocationDetails->push_back(std::move(details));
+        } else {
+            const Split* split = nullptr;
+            if (evaluateAllocation<Trace>(allocation, subject, flag.totalShards, now, logger,
+                                          split, nullptr) == AllocationEvaluationCode::MATCH) {
+                matchedAllocation = &allocation;
+                matchedSplit = split;
+                return;
+            }
         }
     }
+}
+
+// Create the assignment event for a match, if the allocation logs assignments
+std::optional<AssignmentEvent> createAssignmentEvent(const FlagConfiguration& flag,
+                                                     const Allocation& allocation,
+                                                     const Split& split,
+                                                     const SubjectContext& subject,
+                                                     const std::string& timestamp) {
+    bool shouldLog = true;
+    if (allocation.doLog.has_value()) {
+        shouldLog = allocation.doLog.value();
+    }
+    if (!shouldLog) {
+        return std::nullopt;
+    }
 
-    if (!foundMatchingSplit) {
-        details.allocationEvaluationCode = AllocationEvaluationCode::TRAFFIC_EXPOSURE_MISS;
-        return details;
+    AssignmentEvent event;
+    event.featureFlag = flag.key;
+    event.allocation = allocation.key;
+    event.experiment = flag.key + "-" + allocation.key;
+    event.variation = split.variationKey;
+    event.subject = subject.getSubjectKey();
+    event.subjectAttributes = subject.getSubjectAttributes();
+    event.timestamp = timestamp;
+    event.metaData = {{"sdkLanguage", "cpp"}, {"sdkVersion", SDK_VERSION}};
+
+    // Convert extraLogging JSON to map of strings
+    if (split.extraLogging.is_object()) {
+        for (auto& [key, value] : split.extraLogging.items()) {
+            if (value.is_string()) {
+                event.extraLogging[key] = value.get<std::string>();
+            } else {
+                event.extraLogging[key] = value.dump();
+            }
+        }
     }
 
-    details.allocationEvaluationCode = AllocationEvaluationCode::MATCH;
-    return details;
+    return event;
 }
 
-// Evaluate a flag and return detailed evaluation information
-EvalResultWithDetails evalFlagDetails(const FlagConfiguration& flag, const std::string& subjectKey,
-                                      const Attributes& subjectAttributes,
-                                      ApplicationLogger* logger) {
+template <typename Trace>
+EvalResultWithDetails evalFlagDetailsWithTrace(const FlagConfiguration& flag,
+                                               const SubjectContext& subject,
+                                               ApplicationLogger* logger) {
     auto now = std::chrono::system_clock::now();
     std::string timestamp = formatISOTimestamp(now);
 
     EvalResultWithDetails result;
     result.details.flagKey = flag.key;
-    result.details.subjectKey = subjectKey;
-    result.details.subjectAttributes = subjectAttributes;
+    result.details.subjectKey = subject.getSubjectKey();
+    result.details.subjectAttributes = subject.getSubjectAttributes();
     result.details.timestamp = timestamp;
 
     // Check if flag is enabled
@@ -168,45 +268,11 @@ EvalResultWithDetails evalFlagDetails(const FlagConfiguration& flag, const std::
         return result;
     }
 
-    Attributes augmentedSubjectAttributes = augmentWithSubjectKey(subjectAttributes, subjectKey);
-
     // Evaluate all allocations and track details
     const Allocation* matchedAllocation = nullptr;
     const Split* matchedSplit = nullptr;
-    bool foundMatch = false;
-
-    for (size_t i = 0; i < flag.allocations.size(); ++i) {
-        const auto& allocation = flag.allocations[i];
-
-        AllocationEvaluationDetails allocDetails;
-
-        // If we already found a match, mark remaining allocations as UNEVALUATED
-        if (foundMatch) {
-            allocDetails.key = allocation.key;
-            allocDetails.orderPosition = i + 1;  // 1-indexed to match shared test data
-            allocDetails.allocationEvaluationCode = AllocationEvaluationCode::UNEVALUATED;
-        } else {
-            // Track allocation evaluation details
-            allocDetails = evaluateAllocationWithDetails(
-                allocation, subjectKey, augmentedSubjectAttributes, flag.totalShards, now,
-                i + 1,  // 1-indexed to match shared test data
-                logger);
-
-            // If this allocation matched and we don't have a match yet, use it
-            if (allocDetails.allocationEvaluationCode == AllocationEvaluationCode::MATCH) {
-                const Split* split =
-                    findMatchingSplit(allocation, subjectKey, augmentedSubjectAttributes,
-                                      flag.totalShards, now, logger);
-                if (split != nullptr) {
-                    matchedAllocation = &allocation;
-                    matchedSplit = split;
-                    foundMatch = true;
-                }
-            }
-        }
-
-        result.details.allocations.push_back(allocDetails);
-    }
+    evaluateAllocations<Trace>(flag, subject, now, logger, matchedAllocation, matchedSplit,
+                               &result.details.allocations);
 
     if (matchedAllocation == nullptr || matchedSplit == nullptr) {
         result.details.flagEvaluationCode = FlagEvaluationCode::DEFAULT_ALLOCATION_NULL;
@@ -230,39 +296,86 @@ EvalResultWithDetails evalFlagDetails(const FlagConfiguration& flag, const std::
     result.details.flagEvaluationDescription = "Flag evaluation successful";
 
     // Create assignment event if logging is enabled
-    bool shouldLog = true;
-    if (matchedAllocation->doLog.has_value()) {
-        shouldLog = matchedAllocation->doLog.value();
+    result.event =
+        createAssignmentEvent(flag, *matchedAllocation, *matchedSplit, subject, timestamp);
+
+    return result;
+}
+
+}  // namespace
+
+// Evaluate a flag for a given subject
+// Returns std::nullopt if evaluation fails
+std::optional<EvalResult> evalFlag(const FlagConfiguration& flag, const std::string& subjectKey,
+                                   const Attributes& subjectAttributes, ApplicationLogger* logger) {
+    SubjectContext subject(subjectKey, subjectAttributes);
+    return evalFlag(flag, subject, logger);
+}
+
+// Evaluate a flag for a subject whose attributes are already resolved
+std::optional<EvalResult> evalFlag(const FlagConfiguration& flag, const SubjectContext& subject,
+                                   ApplicationLogger* logger) {
+    // Check if flag is enabled
+    if (!flag.enabled) {
+        if (logger) {
+            logger->log(LogLevel::Info, [&] { return "Flag is not enabled: " + flag.key; });
+        }
+        return std::nullopt;
     }
 
-    if (shouldLog) {
-        AssignmentEvent event;
-        event.featureFlag = flag.key;
-        event.allocation = matchedAllocation->key;
-        event.experiment = flag.key + "-" + matchedAllocation->key;
-        event.variation = matchedSplit->variationKey;
-        event.subject = subjectKey;
-        event.subjectAttributes = subjectAttributes;
-        event.timestamp = timestamp;
-        event.metaData = {{"sdkLanguage", "cpp"}, {"sdkVersion", SDK_VERSION}};
-
-        // Convert extraLogging JSON to map of strings
-        if (matchedSplit->extraLogging.is_object()) {
-            for (auto& [key, value] : matchedSplit->extraLogging.items()) {
-                if (value.is_string()) {
-                    event.extraLogging[key] = value.get<std::string>();
-                } else {
-                    event.extraLogging[key] = value.dump();
-                }
-            }
+    auto now = std::chrono::system_clock::now();
+
+    // Find matching allocation and split
+    const Allocation* matchedAllocation = nullptr;
+    const Split* matchedSplit = nullptr;
+    evaluateAllocations<NoTrace>(flag, subject, now, logger, matchedAllocation, matchedSplit,
+                                 nullptr);
+
+    if (matchedAllocation == nullptr || matchedSplit == nullptr) {
+        if (logger) {
+            logger->log(LogLevel::Info, [] { return "Subject is not part of any allocation"; });
         }
+        return std::nullopt;
+    }
 
-        result.event = event;
+    // Find the variation value
+    auto it = flag.parsedVariations.find(matchedSplit->variationKey);
+    if (it == flag.parsedVariations.end()) {
+        if (logger) {
+            logger->log(LogLevel::Error,
+                        [&] { return "Cannot find variation: " + matchedSplit->variationKey; });
+        }
+        return std::nullopt;
     }
 
+    EvalResult result;
+    result.value = it->second;
+
+    // Create assignment event if logging is enabled
+    result.event = createAssignmentEvent(flag, *matchedAllocation, *matchedSplit, subject,
+                                         formatISOTimestamp(now));
+
     return result;
 }
 
+// Evaluate a flag and return detailed evaluation information
+EvalResultWithDetails evalFlagDetails(const FlagConfiguration& flag, const std::string& subjectKey,
+                                      const Attributes& subjectAttributes,
+                                      ApplicationLogger* logger, EvaluationTraceLevel traceLevel) {
+    SubjectContext subject(subjectKey, subjectAttributes);
+    return evalFlagDetails(flag, subject, logger, traceLevel);
+}
+
+// Evaluate a flag for a subject whose attributes are already resolved and
+// return detailed evaluation information
+EvalResultWithDetails evalFlagDetails(const FlagConfiguration& flag, const SubjectContext& subject,
+                                      ApplicationLogger* logger, EvaluationTraceLevel traceLevel) {
+    if (traceLevel == EvaluationTraceLevel::FULL) {
+        return evalFlagDetailsWithTrace<FullTrace>(flag, subject, logger);
+    }
+    return evalFlagDetailsWithTrace<AllocationTrace>(flag, subject, logger);
+}
+
 // Augment subject attributes by setting "id" attribute to subjectKey
 // if "id" is not already present
 Attributes augmentWithSubjectKey(const Attributes& subjectAttributes,
@@ -284,35 +397,65 @@ const Split* findMatchingSplit(const Allocation& allocation, const std::string&
                                const Attributes& augmentedSubjectAttributes, int64_t totalShards,
                                const std::chrono::system_clock::time_point& now,
                                ApplicationLogger* logger) {
-    // Check time constraints
-    if (allocation.startAt.has_value() && now < allocation.startAt.value()) {
-        return nullptr;
-    }
-    if (allocation.endAt.has_value() && now > allocation.endAt.value()) {
-        return nullptr;
-    }
+    SubjectContext subject(subjectKey, augmentedSubjectAttributes);
+    return findMatchingSplit(allocation, subject, totalShards, now, logger);
+}
 
-    // Check if any rule matches
-    bool matchesRule = false;
-    for (const auto& rule : allocation.rules) {
-        if (internal::ruleMatches(rule, augmentedSubjectAttributes, logger)) {
-            matchesRule = true;
-            break;
-        }
-    }
+// Find a matching split for a subject whose attributes are already resolved
+const Split* findMatchingSplit(const Allocation& allocation, const SubjectContext& subject,
+                               int64_t totalShards,
+                               const std::chrono::system_clock::time_point& now,
+                               ApplicationLogger* logger) {
+    const Split* split = nullptr;
+    evaluateAllocation<NoTrace>(allocation, subject, totalShards, now, logger, split, nullptr);
+    return split;
+}
 
-    // If there are rules and none match, return nullptr
-    if (!allocation.rules.empty() && !matchesRule) {
+// Select the first split that matches the given subject
+const Split* selectSplit(const Allocation& allocation, const std::string& subjectKey,
+                         int64_t totalShards) {
+    const SplitIndex& index = allocation.splitIndex;
+    if (!index.valid || index.splitCount != allocation.splits.size()) {
+        for (const auto& split : allocation.splits) {
+            if (splitMatches(split, subjectKey, totalShards)) {
+                return &split;
+            }
+        }
         return nullptr;
     }
 
-    // Find matching split
-    for (const auto& split : allocation.splits) {
-        if (splitMatches(split, subjectKey, totalShards)) {
-            return &split;
+    // Intersect the splits accepting the subject's shard value for every salt
+    uint64_t inlineCandidates[4];
+    std::vector<uint64_t> heapCandidates;
+    uint64_t* candidates = inlineCandidates;
+    if (index.words > 4) {
+        heapCandidates.resize(index.words);
+        candidates = heapCandidates.data();
+    }
+    std::copy(index.allSplits.begin(), index.allSplits.end(), candidates);
+    for (const auto& table : index.salts) {
+        int64_t shard = getShard(table.salt + "-" + subjectKey, totalShards);
+        size_t region = static_cast<size_t>(
+            std::upper_bound(table.boundaries.begin(), table.boundaries.end(), shard) -
+            table.boundaries.begin());
+        const uint64_t* mask = &table.masks[region * index.words];
+        for (size_t w = 0; w < index.words; ++w) {
+            candidates[w] &= mask[w];
         }
     }
 
+    for (size_t w = 0; w < index.words; ++w) {
+        uint64_t word = candidates[w];
+        if (word == 0) {
+            continue;
+        }
+        size_t bit = 0;
+        while ((word & 1) == 0) {
+            word >>= 1;
+            ++bit;
+        }
+        return &allocation.splits[w * 64 + bit];
+    }
     return nullptr;
 }
 
@@ -341,15 +484,22 @@ bool shardMatches(const Shard& shard, const std::string& subjectKey, int64_t tot
 int64_t getShard(const std::string& input, int64_t totalShards) {
     unsigned char hash[MD5_DIGEST_LENGTH];
     md5_hash(input.c_str(), input.length(), hash);
+    return internal::shardFromDigest(hash, totalShards);
+}
 
+namespace internal {
+
+int64_t shardFromDigest(const unsigned char* digest, int64_t totalShards) {
     // Use first 4 bytes of MD5 hash in big-endian format
-    uint32_t intVal = (static_cast<uint32_t>(hash[0]) << 24) |
-                      (static_cast<uint32_t>(hash[1]) << 16) |
-                      (static_cast<uint32_t>(hash[2]) << 8) | static_cast<uint32_t>(hash[3]);
+    uint32_t intVal = (static_cast<uint32_t>(digest[0]) << 24) |
+                      (static_cast<uint32_t>(digest[1]) << 16) |
+                      (static_cast<uint32_t>(digest[2]) << 8) | static_cast<uint32_t>(digest[3]);
 
     return static_cast<int64_t>(intVal) % totalShards;
 }
 
+}  // namespace internal
+
 // Check if shard is within the given range
 bool isShardInRange(int64_t shard, const ShardRange& range) {
     return shard >= range.start && shard < range.end;
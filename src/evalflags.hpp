@@ -10,6 +10,7 @@
 #include "application_logger.hpp"
 #include "config_response.hpp"
 #include "rules.hpp"
+#include "subject_context.hpp"
 
 namespace eppoclient {
 
@@ -56,7 +57,8 @@ enum class AllocationEvaluationCode {
     TRAFFIC_EXPOSURE_MISS
 };
 
-// Forward declarations for evaluation details
+// Rule, condition, split and shard evaluation details
+// Only recorded when evaluating with EvaluationTraceLevel::FULL
 struct ConditionEvaluationDetails {
     nlohmann::json condition;
     std::optional<std::variant<std::string, int64_t, double, bool>> attributeValue;
@@ -129,6 +131,11 @@ struct EvalResultWithDetails {
 int64_t getShard(const std::string& input, int64_t totalShards);
 bool isShardInRange(int64_t shard, const ShardRange& range);
 
+namespace internal {
+// Compute the shard value of an input from its MD5 digest, as getShard() does
+int64_t shardFromDigest(const unsigned char* digest, int64_t totalShards);
+}  // namespace internal
+
 // Augment subject attributes with subject key
 Attributes augmentWithSubjectKey(const Attributes& subjectAttributes,
                                  const std::string& subjectKey);
@@ -144,10 +151,29 @@ std::optional<EvalResult> evalFlag(const FlagConfiguration& flag, const std::str
                                    const Attributes& subjectAttributes,
                                    ApplicationLogger* logger = nullptr);
 
+// Evaluate a flag for a subject whose attributes are already resolved
+// Returns std::nullopt if evaluation fails
+std::optional<EvalResult> evalFlag(const FlagConfiguration& flag, const SubjectContext& subject,
+                                   ApplicationLogger* logger = nullptr);
+
+// How much of a flag evaluation evalFlagDetails records
+enum class EvaluationTraceLevel {
+    ALLOCATIONS,  // Evaluation code of every allocation
+    FULL          // Also every evaluated rule, condition, split and shard
+};
+
 // Evaluate a flag and return detailed evaluation information
-EvalResultWithDetails evalFlagDetails(const FlagConfiguration& flag, const std::string& subjectKey,
-                                      const Attributes& subjectAttributes,
-                                      ApplicationLogger* logger = nullptr);
+EvalResultWithDetails evalFlagDetails(
+    const FlagConfiguration& flag, const std::string& subjectKey,
+    const Attributes& subjectAttributes, ApplicationLogger* logger = nullptr,
+    EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+// Evaluate a flag for a subject whose attributes are already resolved and
+// return detailed evaluation information
+EvalResultWithDetails evalFlagDetails(
+    const FlagConfiguration& flag, const SubjectContext& subject,
+    ApplicationLogger* logger = nullptr,
+    EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
 // Allocation member functions
 // Find a matching split for the given subject
@@ -156,6 +182,18 @@ const Split* findMatchingSplit(const Allocation& allocation, const std::string&
                                const std::chrono::system_clock::time_point& now,
                                ApplicationLogger* logger = nullptr);
 
+// Find a matching split for a subject whose attributes are already resolved
+const Split* findMatchingSplit(const Allocation& allocation, const SubjectContext& subject,
+                               int64_t totalShards,
+                               const std::chrono::system_clock::time_point& now,
+                               ApplicationLogger* logger = nullptr);
+
+// Select the first split of an allocation that matches the given subject, using the
+// allocation's split index when it has been precomputed
+// Returns nullptr if no split matches
+const Split* selectSplit(const Allocation& allocation, const std::string& subjectKey,
+                         int64_t totalShards);
+
 // Split member functions
 // Check if a split matches the given subject
 bool splitMatches(const Split& split, const std::string& subjectKey, int64_t totalShards);
@@ -1,5 +1,6 @@
 #include "evaluation_client.hpp"
 #include <chrono>
+#include <utility>
 #include "time_utils.hpp"
 
 namespace eppoclient {
@@ -16,8 +17,18 @@ EvaluationClient::EvaluationClient(const Configuration& configuration,
       banditLogger_(banditLogger),
       applicationLogger_(applicationLogger) {}
 
-bool EvaluationClient::getBooleanAssignment(const std::string& flagKey,
-                                            const std::string& subjectKey,
+EvaluationClient::EvaluationClient(std::shared_ptr<const Configuration> configuration,
+                                   AssignmentLogger& assignmentLogger, BanditLogger& banditLogger,
+                                   ApplicationLogger& applicationLogger,
+                                   AssignmentResultCache& assignmentResultCache)
+    : configuration_(*configuration),
+      assignmentLogger_(assignmentLogger),
+      banditLogger_(banditLogger),
+      applicationLogger_(applicationLogger),
+      assignmentResultCache_(&assignmentResultCache),
+      configurationSnapshot_(std::move(configuration)) {}
+
+bool EvaluationClient::getBooleanAssignment(std::string_view flagKey, std::string_view subjectKey,
                                             const Attributes& subjectAttributes,
                                             bool defaultValue) {
     auto variation = getAssignment(configuration_, flagKey, subjectKey, subjectAttributes,
@@ -25,8 +36,7 @@ bool EvaluationClient::getBooleanAssignment(const std::string& flagKey,
     return extractVariation(variation, flagKey, VariationType::BOOLEAN, defaultValue);
 }
 
-double EvaluationClient::getNumericAssignment(const std::string& flagKey,
-                                              const std::string& subjectKey,
+double EvaluationClient::getNumericAssignment(std::string_view flagKey, std::string_view subjectKey,
                                               const Attributes& subjectAttributes,
                                               double defaultValue) {
     auto variation = getAssignment(configuration_, flagKey, subjectKey, subjectAttributes,
@@ -34,8 +44,8 @@ double EvaluationClient::getNumericAssignment(const std::string& flagKey,
     return extractVariation(variation, flagKey, VariationType::NUMERIC, defaultValue);
 }
 
-int64_t EvaluationClient::getIntegerAssignment(const std::string& flagKey,
-                                               const std::string& subjectKey,
+int64_t EvaluationClient::getIntegerAssignment(std::string_view flagKey,
+                                               std::string_view subjectKey,
                                                const Attributes& subjectAttributes,
                                                int64_t defaultValue) {
     auto variation = getAssignment(configuration_, flagKey, subjectKey, subjectAttributes,
@@ -43,8 +53,8 @@ int64_t EvaluationClient::getIntegerAssignment(const std::string& flagKey,
     return extractVariation(variation, flagKey, VariationType::INTEGER, defaultValue);
 }
 
-std::string EvaluationClient::getStringAssignment(const std::string& flagKey,
-                                                  const std::string& subjectKey,
+std::string EvaluationClient::getStringAssignment(std::string_view flagKey,
+                                                  std::string_view subjectKey,
                                                   const Attributes& subjectAttributes,
                                                   const std::string& defaultValue) {
     auto variation = getAssignment(configuration_, flagKey, subjectKey, subjectAttributes,
@@ -52,8 +62,8 @@ std::string EvaluationClient::getStringAssignment(const std::string& flagKey,
     return extractVariation(variation, flagKey, VariationType::STRING, defaultValue);
 }
 
-nlohmann::json EvaluationClient::getJSONAssignment(const std::string& flagKey,
-                                                   const std::string& subjectKey,
+nlohmann::json EvaluationClient::getJSONAssignment(std::string_view flagKey,
+                                                   std::string_view subjectKey,
                                                    const Attributes& subjectAttributes,
                                                    const nlohmann::json& defaultValue) {
     auto variation =
@@ -61,8 +71,8 @@ nlohmann::json EvaluationClient::getJSONAssignment(const std::string& flagKey,
     return extractVariation(variation, flagKey, VariationType::JSON, defaultValue);
 }
 
-std::string EvaluationClient::getSerializedJSONAssignment(const std::string& flagKey,
-                                                          const std::string& subjectKey,
+std::string EvaluationClient::getSerializedJSONAssignment(std::string_view flagKey,
+                                                          std::string_view subjectKey,
                                                           const Attributes& subjectAttributes,
                                                           const std::string& defaultValue) {
     auto variation =
@@ -75,21 +85,100 @@ std::string EvaluationClient::getSerializedJSONAssignment(const std::string& fla
     if (!std::holds_alternative<nlohmann::json>(*variation)) {
         std::string actualType = detectVariationType(*variation);
         std::string expectedType = variationTypeToString(VariationType::JSON);
-        applicationLogger_.error("Variation value does not have the correct type. Found " +
-                                 actualType + ", but expected " + expectedType + " for flag " +
-                                 flagKey);
+        applicationLogger_.log(LogLevel::Error, [&] {
+            return "Variation value does not have the correct type. Found " + actualType +
+                   ", but expected " + expectedType + " for flag " + std::string(flagKey);
+        });
         return defaultValue;
     }
 
     return std::get<nlohmann::json>(*variation).dump();
 }
 
+bool EvaluationClient::getBooleanAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                            bool defaultValue) {
+    auto variation = getAssignment(configuration_, flagKey, subject, VariationType::BOOLEAN);
+    return extractVariation(variation, flagKey, VariationType::BOOLEAN, defaultValue);
+}
+
+double EvaluationClient::getNumericAssignment(std::string_view flagKey,
+                                              const SubjectContext& subject, double defaultValue) {
+    auto variation = getAssignment(configuration_, flagKey, subject, VariationType::NUMERIC);
+    return extractVariation(variation, flagKey, VariationType::NUMERIC, defaultValue);
+}
+
+int64_t EvaluationClient::getIntegerAssignment(std::string_view flagKey,
+                                               const SubjectContext& subject,
+                                               int64_t defaultValue) {
+    auto variation = getAssignment(configuration_, flagKey, subject, VariationType::INTEGER);
+    return extractVariation(variation, flagKey, VariationType::INTEGER, defaultValue);
+}
+
+std::string EvaluationClient::getStringAssignment(std::string_view flagKey,
+                                                  const SubjectContext& subject,
+                                                  const std::string& defaultValue) {
+    auto variation = getAssignment(configuration_, flagKey, subject, VariationType::STRING);
+    return extractVariation(variation, flagKey, VariationType::STRING, defaultValue);
+}
+
+nlohmann::json EvaluationClient::getJSONAssignment(std::string_view flagKey,
+                                                   const SubjectContext& subject,
+                                                   const nlohmann::json& defaultValue) {
+    auto variation = getAssignment(configuration_, flagKey, subject, VariationType::JSON);
+    return extractVariation(variation, flagKey, VariationType::JSON, defaultValue);
+}
+
 std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>
-EvaluationClient::getAssignment(const Configuration& config, const std::string& flagKey,
-                                const std::string& subjectKey, const Attributes& subjectAttributes,
+EvaluationClient::getAssignment(const Configuration& config, std::string_view flagKey,
+                                std::string_view subjectKey, const Attributes& subjectAttributes,
                                 VariationType variationType) {
+    const FlagConfiguration* flag = config.getFlagConfiguration(flagKey);
+    bool typeMatches = flag != nullptr && verifyType(*flag, variationType);
+    return getAssignment(config, flagKey, flag, typeMatches, subjectKey, subjectAttributes,
+                         variationType);
+}
+
+std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>
+EvaluationClient::getAssignment(const Configuration& config, std::string_view flagKey,
+                                const SubjectContext& subject, VariationType variationType) {
+    const FlagConfiguration* flag = config.getFlagConfiguration(flagKey);
+    bool typeMatches = flag != nullptr && verifyType(*flag, variationType);
+    return getAssignment(config, flagKey, flag, typeMatches, subject, variationType);
+}
+
+std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>
+EvaluationClient::getAssignment(const Configuration& config, std::string_view flagKey,
+                                const FlagConfiguration* flag, bool typeMatches,
+                                std::string_view subjectKey, const Attributes& subjectAttributes,
+                                VariationType variationType) {
+    // Serve repeated evaluations from the result cache, logging the cached
+    // assignment event again for the assignment logger to deduplicate
+    if (assignmentResultCache_ != nullptr) {
+        auto cached = assignmentResultCache_->get(configurationSnapshot_, flagKey, subjectKey,
+                                                  subjectAttributes, variationType);
+        if (cached != nullptr) {
+            logAssignment(cached->event);
+            return cached->value;
+        }
+    }
+
+    // The attributes are only used for this flag, so resolving them against the
+    // configuration only pays off if the flag matches several patterns of a set
+    std::optional<SubjectContext> subject;
+    if (flag != nullptr && flag->usesPatternSets) {
+        subject.emplace(config, subjectKey, subjectAttributes);
+    } else {
+        subject.emplace(subjectKey, subjectAttributes);
+    }
+    return getAssignment(config, flagKey, flag, typeMatches, *subject, variationType);
+}
+
+std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>
+EvaluationClient::getAssignment(const Configuration& config, std::string_view flagKey,
+                                const FlagConfiguration* flag, bool typeMatches,
+                                const SubjectContext& subject, VariationType variationType) {
     // Validate inputs
-    if (subjectKey.empty()) {
+    if (subject.getSubjectKey().empty()) {
         applicationLogger_.error("No subject key provided");
         return std::nullopt;
     }
@@ -99,32 +188,54 @@ EvaluationClient::getAssignment(const Configuration& config, const std::string&
         return std::nullopt;
     }
 
-    // Get flag configuration
-    const FlagConfiguration* flag = config.getFlagConfiguration(flagKey);
     if (flag == nullptr) {
-        applicationLogger_.info("Failed to get flag configuration for: " + flagKey);
+        applicationLogger_.log(LogLevel::Info, [&] {
+            return "Failed to get flag configuration for: " + std::string(flagKey);
+        });
         return std::nullopt;
     }
 
     // Verify flag type
-    if (!verifyType(*flag, variationType)) {
-        applicationLogger_.warn("Failed to verify flag type for: " + flagKey +
-                                " (expected: " + variationTypeToString(variationType) +
-                                ", actual: " + variationTypeToString(flag->variationType) + ")");
+    if (!typeMatches) {
+        applicationLogger_.log(LogLevel::Warn, [&] {
+            return "Failed to verify flag type for: " + std::string(flagKey) +
+                   " (expected: " + variationTypeToString(variationType) +
+                   ", actual: " + variationTypeToString(flag->variationType) + ")";
+        });
         return std::nullopt;
     }
 
-    // Evaluate flag
-    std::optional<EvalResult> result =
-        evalFlag(*flag, subjectKey, subjectAttributes, &applicationLogger_);
+    return evaluateAssignment(config, *flag, flagKey, subject, variationType);
+}
+
+std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>
+EvaluationClient::evaluateAssignment(const Configuration& config, const FlagConfiguration& flag,
+                                     std::string_view flagKey, const SubjectContext& subject,
+                                     VariationType variationType) {
+    // Evaluate flag, falling back to name lookups if the subject's attributes
+    // were resolved against another configuration
+    std::optional<EvalResult> result;
+    if (subject.isResolvedFor(config) || !subject.isResolved()) {
+        result = evalFlag(flag, subject, &applicationLogger_);
+    } else {
+        SubjectContext unresolvedSubject(subject.getSubjectKey(), subject.getSubjectAttributes());
+        result = evalFlag(flag, unresolvedSubject, &applicationLogger_);
+    }
     if (!result.has_value()) {
-        applicationLogger_.info("Failed to evaluate flag: " + flagKey);
+        applicationLogger_.log(LogLevel::Info,
+                               [&] { return "Failed to evaluate flag: " + std::string(flagKey); });
         return std::nullopt;
     }
 
     // Log assignment event
     logAssignment(result->event);
 
+    if (assignmentResultCache_ != nullptr && &config == configurationSnapshot_.get()) {
+        assignmentResultCache_->put(configurationSnapshot_, flag, flagKey,
+                                    subject.getSubjectKey(), subject.getSubjectAttributes(),
+                                    variationType, *result);
+    }
+
     return result->value;
 }
 
@@ -140,10 +251,29 @@ void EvaluationClient::logBanditAction(const BanditEvent& event) {
     banditLogger_.logBanditAction(event);
 }
 
-BanditResult EvaluationClient::getBanditAction(
-    const std::string& flagKey, const std::string& subjectKey,
-    const ContextAttributes& subjectAttributes,
-    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation) {
+namespace {
+
+BanditEvaluationContext makeBanditContext(std::string_view flagKey, std::string_view subjectKey,
+                                          const ContextAttributes& subjectAttributes,
+                                          const std::map<std::string, ContextAttributes>& actions) {
+    return BanditEvaluationContext(flagKey, subjectKey, subjectAttributes, actions);
+}
+
+BanditColumnarEvaluationContext makeBanditContext(std::string_view flagKey,
+                                                  std::string_view subjectKey,
+                                                  const ContextAttributes& subjectAttributes,
+                                                  const BanditActionTable& actions) {
+    return BanditColumnarEvaluationContext(flagKey, subjectKey, subjectAttributes, actions);
+}
+
+}  // namespace
+
+template <typename ActionSet>
+BanditResult EvaluationClient::getBanditActionFrom(std::string_view flagKey,
+                                                   std::string_view subjectKey,
+                                                   const ContextAttributes& subjectAttributes,
+                                                   const ActionSet& actions,
+                                                   const std::string& defaultVariation) {
     // Ignoring the error here as we can always proceed with default variation
     std::string variation = defaultVariation;
     auto assignmentValue =
@@ -171,30 +301,45 @@ BanditResult EvaluationClient::getBanditAction(
     }
 
     // Evaluate bandit
-    BanditEvaluationContext evalContext;
-    evalContext.flagKey = flagKey;
-    evalContext.subjectKey = subjectKey;
-    evalContext.subjectAttributes = subjectAttributes;
-    evalContext.actions = actions;
-
-    BanditEvaluationDetails evaluation = evaluateBandit(bandit->modelData, evalContext);
+    BanditEvaluationDetails evaluation = evaluateBandit(
+        bandit->modelData, makeBanditContext(flagKey, subjectKey, subjectAttributes, actions));
+
+    BanditResult result(variation, evaluation.actionKey);
+
+    // Log bandit action; the event is only built if the logger keeps it
+    if (banditLogger_.shouldLogBanditAction(evaluation.flagKey, evaluation.subjectKey,
+                                            bandit->banditKey, evaluation.actionKey)) {
+        logBanditAction(createBanditEvent(evaluation.flagKey, evaluation.subjectKey,
+                                          bandit->banditKey, bandit->modelVersion,
+                                          std::move(evaluation),
+                                          formatISOTimestamp(std::chrono::system_clock::now())));
+    }
 
-    // Log bandit action
-    BanditEvent event =
-        createBanditEvent(flagKey, subjectKey, bandit->banditKey, bandit->modelVersion, evaluation,
-                          formatISOTimestamp(std::chrono::system_clock::now()));
+    return result;
+}
 
-    logBanditAction(event);
+BanditResult EvaluationClient::getBanditAction(
+    std::string_view flagKey, std::string_view subjectKey,
+    const ContextAttributes& subjectAttributes,
+    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation) {
+    return getBanditActionFrom(flagKey, subjectKey, subjectAttributes, actions, defaultVariation);
+}
 
-    return BanditResult(variation, evaluation.actionKey);
+BanditResult EvaluationClient::getBanditActionColumnar(std::string_view flagKey,
+                                                       std::string_view subjectKey,
+                                                       const ContextAttributes& subjectAttributes,
+                                                       const BanditActionTable& actions,
+                                                       const std::string& defaultVariation) {
+    return getBanditActionFrom(flagKey, subjectKey, subjectAttributes, actions, defaultVariation);
 }
 
 EvaluationResult<std::string> EvaluationClient::getBanditActionDetails(
-    const std::string& flagKey, const std::string& subjectKey,
+    std::string_view flagKey, std::string_view subjectKey,
     const ContextAttributes& subjectAttributes,
-    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation) {
+    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation,
+    EvaluationTraceLevel traceLevel) {
     auto assignmentResult = getStringAssignmentDetails(
-        flagKey, subjectKey, toGenericAttributes(subjectAttributes), defaultVariation);
+        flagKey, subjectKey, toGenericAttributes(subjectAttributes), defaultVariation, traceLevel);
 
     std::string variation = assignmentResult.variation;
     EvaluationDetails details = assignmentResult.evaluationDetails.value_or(EvaluationDetails());
@@ -220,26 +365,23 @@ EvaluationResult<std::string> EvaluationClient::getBanditActionDetails(
     }
 
     // Evaluate bandit
-    BanditEvaluationContext evalContext;
-    evalContext.flagKey = flagKey;
-    evalContext.subjectKey = subjectKey;
-    evalContext.subjectAttributes = subjectAttributes;
-    evalContext.actions = actions;
-
+    BanditEvaluationContext evalContext(flagKey, subjectKey, subjectAttributes, actions);
     BanditEvaluationDetails evaluation = evaluateBandit(bandit->modelData, evalContext);
 
-    // Log bandit action
-    BanditEvent event = createBanditEvent(flagKey, subjectKey, bandit->banditKey,
-                                          bandit->modelVersion, evaluation, details.timestamp);
-
-    logBanditAction(event);
-
     // Set bandit details
     details.banditEvaluationCode = BanditEvaluationCode::MATCH;
     details.banditKey = bandit->banditKey;
     details.banditAction = evaluation.actionKey;
 
-    return EvaluationResult<std::string>(variation, evaluation.actionKey, details);
+    // Log bandit action; the event is only built if the logger keeps it
+    if (banditLogger_.shouldLogBanditAction(evaluation.flagKey, evaluation.subjectKey,
+                                            bandit->banditKey, evaluation.actionKey)) {
+        logBanditAction(createBanditEvent(evaluation.flagKey, evaluation.subjectKey,
+                                          bandit->banditKey, bandit->modelVersion,
+                                          std::move(evaluation), details.timestamp));
+    }
+
+    return EvaluationResult<std::string>(variation, details.banditAction, details);
 }
 
 // ============================================================================
@@ -247,46 +389,47 @@ EvaluationResult<std::string> EvaluationClient::getBanditActionDetails(
 // ============================================================================
 
 EvaluationResult<bool> EvaluationClient::getBooleanAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    bool defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    bool defaultValue, EvaluationTraceLevel traceLevel) {
     return getAssignmentDetails<bool>(VariationType::BOOLEAN, flagKey, subjectKey,
-                                      subjectAttributes, defaultValue);
+                                      subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<int64_t> EvaluationClient::getIntegerAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    int64_t defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    int64_t defaultValue, EvaluationTraceLevel traceLevel) {
     return getAssignmentDetails<int64_t>(VariationType::INTEGER, flagKey, subjectKey,
-                                         subjectAttributes, defaultValue);
+                                         subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<double> EvaluationClient::getNumericAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    double defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    double defaultValue, EvaluationTraceLevel traceLevel) {
     return getAssignmentDetails<double>(VariationType::NUMERIC, flagKey, subjectKey,
-                                        subjectAttributes, defaultValue);
+                                        subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<std::string> EvaluationClient::getStringAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    const std::string& defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const std::string& defaultValue, EvaluationTraceLevel traceLevel) {
     return getAssignmentDetails<std::string>(VariationType::STRING, flagKey, subjectKey,
-                                             subjectAttributes, defaultValue);
+                                             subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<nlohmann::json> EvaluationClient::getJsonAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    const nlohmann::json& defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const nlohmann::json& defaultValue, EvaluationTraceLevel traceLevel) {
     return getAssignmentDetails<nlohmann::json>(VariationType::JSON, flagKey, subjectKey,
-                                                subjectAttributes, defaultValue);
+                                                subjectAttributes, defaultValue, traceLevel);
 }
 
 EvaluationResult<std::string> EvaluationClient::getSerializedJsonAssignmentDetails(
-    const std::string& flagKey, const std::string& subjectKey, const Attributes& subjectAttributes,
-    const std::string& defaultValue) {
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const std::string& defaultValue, EvaluationTraceLevel traceLevel) {
     // Get JSON assignment details first
     nlohmann::json defaultJson = nlohmann::json::parse(defaultValue.empty() ? "{}" : defaultValue);
-    auto jsonResult = getJsonAssignmentDetails(flagKey, subjectKey, subjectAttributes, defaultJson);
+    auto jsonResult =
+        getJsonAssignmentDetails(flagKey, subjectKey, subjectAttributes, defaultJson, traceLevel);
 
     // Convert JSON variation to string
     std::string stringifiedVariation = jsonResult.variation.dump();
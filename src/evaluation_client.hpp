@@ -1,17 +1,27 @@
 #ifndef EVALUATION_CLIENT_HPP
 #define EVALUATION_CLIENT_HPP
 
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include "application_logger.hpp"
+#include "assignment_result_cache.hpp"
 #include "config_response.hpp"
 #include "configuration.hpp"
 #include "evalbandits.hpp"
 #include "evalflags.hpp"
 #include "rules.hpp"
+#include "subject_context.hpp"
 
 namespace eppoclient {
 
+class EppoClient;
+class EvaluationSession;
+
+template <typename T>
+class FlagHandle;
+
 // EvaluationResult structure to hold variation and evaluation details
 template <typename T>
 struct EvaluationResult {
@@ -36,6 +46,16 @@ class BanditLogger {
 public:
     virtual ~BanditLogger() = default;
     virtual void logBanditAction(const BanditEvent& event) = 0;
+
+    // Whether an event for this action would be logged. The SDK only builds a
+    // BanditEvent, with its attribute maps, if this returns true; override it to
+    // drop events cheaply, e.g. duplicates.
+    virtual bool shouldLogBanditAction(const std::string& /*flagKey*/,
+                                       const std::string& /*subject*/,
+                                       const std::string& /*banditKey*/,
+                                       const std::string& /*action*/) {
+        return true;
+    }
 };
 
 /**
@@ -78,115 +98,196 @@ public:
                      BanditLogger& banditLogger, ApplicationLogger& applicationLogger);
 
     // Get boolean assignment
-    bool getBooleanAssignment(const std::string& flagKey, const std::string& subjectKey,
+    bool getBooleanAssignment(std::string_view flagKey, std::string_view subjectKey,
                               const Attributes& subjectAttributes, bool defaultValue);
 
     // Get numeric assignment
-    double getNumericAssignment(const std::string& flagKey, const std::string& subjectKey,
+    double getNumericAssignment(std::string_view flagKey, std::string_view subjectKey,
                                 const Attributes& subjectAttributes, double defaultValue);
 
     // Get integer assignment
-    int64_t getIntegerAssignment(const std::string& flagKey, const std::string& subjectKey,
+    int64_t getIntegerAssignment(std::string_view flagKey, std::string_view subjectKey,
                                  const Attributes& subjectAttributes, int64_t defaultValue);
 
     // Get string assignment
-    std::string getStringAssignment(const std::string& flagKey, const std::string& subjectKey,
+    std::string getStringAssignment(std::string_view flagKey, std::string_view subjectKey,
                                     const Attributes& subjectAttributes,
                                     const std::string& defaultValue);
 
     // Get JSON assignment
-    nlohmann::json getJSONAssignment(const std::string& flagKey, const std::string& subjectKey,
+    nlohmann::json getJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
                                      const Attributes& subjectAttributes,
                                      const nlohmann::json& defaultValue);
 
     // Get serialized JSON assignment (returns stringified JSON)
-    std::string getSerializedJSONAssignment(const std::string& flagKey,
-                                            const std::string& subjectKey,
+    std::string getSerializedJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
                                             const Attributes& subjectAttributes,
                                             const std::string& defaultValue);
 
+    // ========== Subject Context Methods ==========
+    //
+    // Evaluating many flags for the same subject is faster with a SubjectContext,
+    // which resolves the subject's attributes once against this configuration:
+    //
+    //   SubjectContext subject(config, "user-123", attrs);
+    //   bool a = evaluationClient.getBooleanAssignment("flag-a", subject, false);
+    //   bool b = evaluationClient.getBooleanAssignment("flag-b", subject, false);
+    //
+    // A context resolved against a different configuration is still evaluated
+    // correctly, by looking attributes up by name.
+
+    // Get boolean assignment
+    bool getBooleanAssignment(std::string_view flagKey, const SubjectContext& subject,
+                              bool defaultValue);
+
+    // Get numeric assignment
+    double getNumericAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                double defaultValue);
+
+    // Get integer assignment
+    int64_t getIntegerAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                 int64_t defaultValue);
+
+    // Get string assignment
+    std::string getStringAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                    const std::string& defaultValue);
+
+    // Get JSON assignment
+    nlohmann::json getJSONAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                     const nlohmann::json& defaultValue);
+
     // Get bandit action
-    BanditResult getBanditAction(const std::string& flagKey, const std::string& subjectKey,
+    BanditResult getBanditAction(std::string_view flagKey, std::string_view subjectKey,
                                  const ContextAttributes& subjectAttributes,
                                  const std::map<std::string, ContextAttributes>& actions,
                                  const std::string& defaultVariation);
 
+    // Get bandit action from a columnar action table
+    BanditResult getBanditActionColumnar(std::string_view flagKey, std::string_view subjectKey,
+                                         const ContextAttributes& subjectAttributes,
+                                         const BanditActionTable& actions,
+                                         const std::string& defaultVariation);
+
     // ========== Assignment Details Methods ==========
+    // traceLevel sets how much of each flag evaluation the details record
 
     // Get boolean assignment with details
-    EvaluationResult<bool> getBooleanAssignmentDetails(const std::string& flagKey,
-                                                       const std::string& subjectKey,
-                                                       const Attributes& subjectAttributes,
-                                                       bool defaultValue);
+    EvaluationResult<bool> getBooleanAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        bool defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get integer assignment with details
-    EvaluationResult<int64_t> getIntegerAssignmentDetails(const std::string& flagKey,
-                                                          const std::string& subjectKey,
-                                                          const Attributes& subjectAttributes,
-                                                          int64_t defaultValue);
+    EvaluationResult<int64_t> getIntegerAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        int64_t defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get numeric assignment with details
-    EvaluationResult<double> getNumericAssignmentDetails(const std::string& flagKey,
-                                                         const std::string& subjectKey,
-                                                         const Attributes& subjectAttributes,
-                                                         double defaultValue);
+    EvaluationResult<double> getNumericAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        double defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get string assignment with details
-    EvaluationResult<std::string> getStringAssignmentDetails(const std::string& flagKey,
-                                                             const std::string& subjectKey,
-                                                             const Attributes& subjectAttributes,
-                                                             const std::string& defaultValue);
+    EvaluationResult<std::string> getStringAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const std::string& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get JSON assignment with details
-    EvaluationResult<nlohmann::json> getJsonAssignmentDetails(const std::string& flagKey,
-                                                              const std::string& subjectKey,
-                                                              const Attributes& subjectAttributes,
-                                                              const nlohmann::json& defaultValue);
+    EvaluationResult<nlohmann::json> getJsonAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const nlohmann::json& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get serialized JSON assignment with details
     EvaluationResult<std::string> getSerializedJsonAssignmentDetails(
-        const std::string& flagKey, const std::string& subjectKey,
-        const Attributes& subjectAttributes, const std::string& defaultValue);
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const std::string& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Get bandit action with details
     EvaluationResult<std::string> getBanditActionDetails(
-        const std::string& flagKey, const std::string& subjectKey,
+        std::string_view flagKey, std::string_view subjectKey,
         const ContextAttributes& subjectAttributes,
         const std::map<std::string, ContextAttributes>& actions,
-        const std::string& defaultVariation);
+        const std::string& defaultVariation,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
     // Generic get assignment details (for advanced use cases)
     template <typename T>
-    EvaluationResult<T> getAssignmentDetails(VariationType variationType,
-                                             const std::string& flagKey,
-                                             const std::string& subjectKey,
-                                             const Attributes& subjectAttributes,
-                                             const T& defaultValue);
+    EvaluationResult<T> getAssignmentDetails(
+        VariationType variationType, std::string_view flagKey, std::string_view subjectKey,
+        const Attributes& subjectAttributes, const T& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
 
 private:
+    // EppoClient and its sessions evaluate through the client's assignment result cache
+    friend class EppoClient;
+    friend class EvaluationSession;
+
+    // Flag handles resolve the flag themselves and evaluate it through this client
+    template <typename T>
+    friend class FlagHandle;
+
     const Configuration& configuration_;
     AssignmentLogger& assignmentLogger_;
     BanditLogger& banditLogger_;
     ApplicationLogger& applicationLogger_;
 
+    // Assignment result cache and the configuration snapshot it is used with, when enabled
+    AssignmentResultCache* assignmentResultCache_ = nullptr;
+    std::shared_ptr<const Configuration> configurationSnapshot_;
+
+    // Evaluate assignments for a configuration snapshot through a result cache
+    EvaluationClient(std::shared_ptr<const Configuration> configuration,
+                     AssignmentLogger& assignmentLogger, BanditLogger& banditLogger,
+                     ApplicationLogger& applicationLogger,
+                     AssignmentResultCache& assignmentResultCache);
+
     // Internal method to get assignment value
     std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>> getAssignment(
-        const Configuration& config, const std::string& flagKey, const std::string& subjectKey,
+        const Configuration& config, std::string_view flagKey, std::string_view subjectKey,
         const Attributes& subjectAttributes, VariationType variationType);
 
+    std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>> getAssignment(
+        const Configuration& config, std::string_view flagKey, const SubjectContext& subject,
+        VariationType variationType);
+
+    // Internal methods to get the assignment value of a flag already looked up in
+    // config (nullptr if not found); typeMatches is the result of verifyType()
+    std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>> getAssignment(
+        const Configuration& config, std::string_view flagKey, const FlagConfiguration* flag,
+        bool typeMatches, std::string_view subjectKey, const Attributes& subjectAttributes,
+        VariationType variationType);
+
+    std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>> getAssignment(
+        const Configuration& config, std::string_view flagKey, const FlagConfiguration* flag,
+        bool typeMatches, const SubjectContext& subject, VariationType variationType);
+
+    // Internal method to evaluate an already resolved and type-checked flag
+    std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>
+    evaluateAssignment(const Configuration& config, const FlagConfiguration& flag,
+                       std::string_view flagKey, const SubjectContext& subject,
+                       VariationType variationType);
+
     // Internal method to log assignment
     void logAssignment(const std::optional<AssignmentEvent>& event);
 
     // Internal method to log bandit action
     void logBanditAction(const BanditEvent& event);
 
+    // Get bandit action from an action map or table
+    template <typename ActionSet>
+    BanditResult getBanditActionFrom(std::string_view flagKey, std::string_view subjectKey,
+                                     const ContextAttributes& subjectAttributes,
+                                     const ActionSet& actions, const std::string& defaultVariation);
+
 
     // Template helper to extract and validate variation value
     template <typename T>
     T extractVariation(
         const std::optional<std::variant<std::string, int64_t, double, bool, nlohmann::json>>&
             variation,
-        const std::string& flagKey, VariationType variationType, const T& defaultValue) {
+        std::string_view flagKey, VariationType variationType, const T& defaultValue) {
         if (!variation.has_value()) {
             return defaultValue;
         }
@@ -194,9 +295,10 @@ private:
         if (!std::holds_alternative<T>(*variation)) {
             std::string actualType = detectVariationType(*variation);
             std::string expectedType = variationTypeToString(variationType);
-            applicationLogger_.error("Variation value does not have the correct type. Found " +
-                                     actualType + ", but expected " + expectedType + " for flag " +
-                                     flagKey);
+            applicationLogger_.log(LogLevel::Error, [&] {
+                return "Variation value does not have the correct type. Found " + actualType +
+                       ", but expected " + expectedType + " for flag " + std::string(flagKey);
+            });
             return defaultValue;
         }
 
@@ -205,8 +307,8 @@ private:
 
     // Template helper to create error result with consistent error handling
     template <typename T>
-    EvaluationResult<T> createErrorResult(const T& defaultValue, const std::string& flagKey,
-                                          const std::string& subjectKey,
+    EvaluationResult<T> createErrorResult(const T& defaultValue, std::string_view flagKey,
+                                          std::string_view subjectKey,
                                           const Attributes& subjectAttributes,
                                           FlagEvaluationCode errorCode,
                                           const std::string& errorDescription) {
@@ -224,10 +326,11 @@ private:
 // Template method implementation
 template <typename T>
 EvaluationResult<T> EvaluationClient::getAssignmentDetails(VariationType variationType,
-                                                           const std::string& flagKey,
-                                                           const std::string& subjectKey,
+                                                           std::string_view flagKey,
+                                                           std::string_view subjectKey,
                                                            const Attributes& subjectAttributes,
-                                                           const T& defaultValue) {
+                                                           const T& defaultValue,
+                                                           EvaluationTraceLevel traceLevel) {
     // Validate inputs
     if (subjectKey.empty()) {
         applicationLogger_.error("No subject key provided");
@@ -245,7 +348,9 @@ EvaluationResult<T> EvaluationClient::getAssignmentDetails(VariationType variati
     // Get flag configuration
     const FlagConfiguration* flag = configuration_.getFlagConfiguration(flagKey);
     if (flag == nullptr) {
-        applicationLogger_.info("Failed to get flag configuration for: " + flagKey);
+        applicationLogger_.log(LogLevel::Info, [&] {
+            return "Failed to get flag configuration for: " + std::string(flagKey);
+        });
         return createErrorResult<T>(defaultValue, flagKey, subjectKey, subjectAttributes,
                                     FlagEvaluationCode::FLAG_UNRECOGNIZED_OR_DISABLED,
                                     "Flag configuration not found");
@@ -253,16 +358,25 @@ EvaluationResult<T> EvaluationClient::getAssignmentDetails(VariationType variati
 
     // Verify flag type
     if (!verifyType(*flag, variationType)) {
-        applicationLogger_.warn("Failed to verify flag type for: " + flagKey +
-                                " (expected: " + variationTypeToString(variationType) +
-                                ", actual: " + variationTypeToString(flag->variationType) + ")");
+        applicationLogger_.log(LogLevel::Warn, [&] {
+            return "Failed to verify flag type for: " + std::string(flagKey) +
+                   " (expected: " + variationTypeToString(variationType) +
+                   ", actual: " + variationTypeToString(flag->variationType) + ")";
+        });
         return createErrorResult<T>(defaultValue, flagKey, subjectKey, subjectAttributes,
                                     FlagEvaluationCode::TYPE_MISMATCH, "Type mismatch");
     }
 
-    // Evaluate flag with details
+    // Evaluate flag with details, resolving the attributes only if the flag matches
+    // several patterns of a set
+    std::optional<SubjectContext> subject;
+    if (flag->usesPatternSets) {
+        subject.emplace(configuration_, subjectKey, subjectAttributes);
+    } else {
+        subject.emplace(subjectKey, subjectAttributes);
+    }
     EvalResultWithDetails result =
-        evalFlagDetails(*flag, subjectKey, subjectAttributes, &applicationLogger_);
+        evalFlagDetails(*flag, *subject, &applicationLogger_, traceLevel);
 
     // Log assignment event
     logAssignment(result.event);
@@ -281,9 +395,10 @@ EvaluationResult<T> EvaluationClient::getAssignmentDetails(VariationType variati
     if (!std::holds_alternative<T>(*result.value)) {
         std::string actualType = detectVariationType(*result.value);
         std::string expectedType = variationTypeToString(variationType);
-        applicationLogger_.error("Variation value does not have the correct type. Found " +
-                                 actualType + ", but expected " + expectedType + " for flag " +
-                                 flagKey);
+        applicationLogger_.log(LogLevel::Error, [&] {
+            return "Variation value does not have the correct type. Found " + actualType +
+                   ", but expected " + expectedType + " for flag " + std::string(flagKey);
+        });
         return EvaluationResult<T>(defaultValue, std::nullopt, result.details);
     }
 
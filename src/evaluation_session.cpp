@@ -0,0 +1,168 @@
+#include "evaluation_session.hpp"
+
+namespace eppoclient {
+
+EvaluationSession::EvaluationSession(std::shared_ptr<const Configuration> configuration,
+                                     std::shared_ptr<AssignmentLogger> assignmentLogger,
+                                     std::shared_ptr<BanditLogger> banditLogger,
+                                     std::shared_ptr<ApplicationLogger> applicationLogger,
+                                     std::shared_ptr<AssignmentResultCache> assignmentResultCache)
+    : configuration_(std::move(configuration)),
+      assignmentLogger_(std::move(assignmentLogger)),
+      banditLogger_(std::move(banditLogger)),
+      applicationLogger_(std::move(applicationLogger)),
+      assignmentResultCache_(std::move(assignmentResultCache)),
+      evaluationClient_(assignmentResultCache_
+                            ? EvaluationClient(configuration_, *assignmentLogger_, *banditLogger_,
+                                               *applicationLogger_, *assignmentResultCache_)
+                            : EvaluationClient(*configuration_, *assignmentLogger_,
+                                               *banditLogger_, *applicationLogger_)) {}
+
+bool EvaluationSession::getBooleanAssignment(std::string_view flagKey, std::string_view subjectKey,
+                                             const Attributes& subjectAttributes,
+                                             bool defaultValue) {
+    return evaluationClient_.getBooleanAssignment(flagKey, subjectKey, subjectAttributes,
+                                                  defaultValue);
+}
+
+double EvaluationSession::getNumericAssignment(std::string_view flagKey,
+                                               std::string_view subjectKey,
+                                               const Attributes& subjectAttributes,
+                                               double defaultValue) {
+    return evaluationClient_.getNumericAssignment(flagKey, subjectKey, subjectAttributes,
+                                                  defaultValue);
+}
+
+int64_t EvaluationSession::getIntegerAssignment(std::string_view flagKey,
+                                                std::string_view subjectKey,
+                                                const Attributes& subjectAttributes,
+                                                int64_t defaultValue) {
+    return evaluationClient_.getIntegerAssignment(flagKey, subjectKey, subjectAttributes,
+                                                  defaultValue);
+}
+
+std::string EvaluationSession::getStringAssignment(std::string_view flagKey,
+                                                   std::string_view subjectKey,
+                                                   const Attributes& subjectAttributes,
+                                                   const std::string& defaultValue) {
+    return evaluationClient_.getStringAssignment(flagKey, subjectKey, subjectAttributes,
+                                                 defaultValue);
+}
+
+nlohmann::json EvaluationSession::getJSONAssignment(std::string_view flagKey,
+                                                    std::string_view subjectKey,
+                                                    const Attributes& subjectAttributes,
+                                                    const nlohmann::json& defaultValue) {
+    return evaluationClient_.getJSONAssignment(flagKey, subjectKey, subjectAttributes,
+                                               defaultValue);
+}
+
+std::string EvaluationSession::getSerializedJSONAssignment(std::string_view flagKey,
+                                                           std::string_view subjectKey,
+                                                           const Attributes& subjectAttributes,
+                                                           const std::string& defaultValue) {
+    return evaluationClient_.getSerializedJSONAssignment(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue);
+}
+
+BanditResult EvaluationSession::getBanditAction(
+    std::string_view flagKey, std::string_view subjectKey,
+    const ContextAttributes& subjectAttributes,
+    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation) {
+    return evaluationClient_.getBanditAction(flagKey, subjectKey, subjectAttributes, actions,
+                                             defaultVariation);
+}
+
+BanditResult EvaluationSession::getBanditActionColumnar(std::string_view flagKey,
+                                                        std::string_view subjectKey,
+                                                        const ContextAttributes& subjectAttributes,
+                                                        const BanditActionTable& actions,
+                                                        const std::string& defaultVariation) {
+    return evaluationClient_.getBanditActionColumnar(flagKey, subjectKey, subjectAttributes,
+                                                     actions, defaultVariation);
+}
+
+bool EvaluationSession::getBooleanAssignment(std::string_view flagKey,
+                                             const SubjectContext& subject, bool defaultValue) {
+    return evaluationClient_.getBooleanAssignment(flagKey, subject, defaultValue);
+}
+
+double EvaluationSession::getNumericAssignment(std::string_view flagKey,
+                                               const SubjectContext& subject, double defaultValue) {
+    return evaluationClient_.getNumericAssignment(flagKey, subject, defaultValue);
+}
+
+int64_t EvaluationSession::getIntegerAssignment(std::string_view flagKey,
+                                                const SubjectContext& subject,
+                                                int64_t defaultValue) {
+    return evaluationClient_.getIntegerAssignment(flagKey, subject, defaultValue);
+}
+
+std::string EvaluationSession::getStringAssignment(std::string_view flagKey,
+                                                   const SubjectContext& subject,
+                                                   const std::string& defaultValue) {
+    return evaluationClient_.getStringAssignment(flagKey, subject, defaultValue);
+}
+
+nlohmann::json EvaluationSession::getJSONAssignment(std::string_view flagKey,
+                                                    const SubjectContext& subject,
+                                                    const nlohmann::json& defaultValue) {
+    return evaluationClient_.getJSONAssignment(flagKey, subject, defaultValue);
+}
+
+// ============================================================================
+// Assignment Details Methods
+// ============================================================================
+
+EvaluationResult<bool> EvaluationSession::getBooleanAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    bool defaultValue, EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getBooleanAssignmentDetails(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue, traceLevel);
+}
+
+EvaluationResult<int64_t> EvaluationSession::getIntegerAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    int64_t defaultValue, EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getIntegerAssignmentDetails(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue, traceLevel);
+}
+
+EvaluationResult<double> EvaluationSession::getNumericAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    double defaultValue, EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getNumericAssignmentDetails(flagKey, subjectKey, subjectAttributes,
+                                                         defaultValue, traceLevel);
+}
+
+EvaluationResult<std::string> EvaluationSession::getStringAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const std::string& defaultValue, EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getStringAssignmentDetails(flagKey, subjectKey, subjectAttributes,
+                                                        defaultValue, traceLevel);
+}
+
+EvaluationResult<nlohmann::json> EvaluationSession::getJsonAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const nlohmann::json& defaultValue, EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getJsonAssignmentDetails(flagKey, subjectKey, subjectAttributes,
+                                                      defaultValue, traceLevel);
+}
+
+EvaluationResult<std::string> EvaluationSession::getSerializedJsonAssignmentDetails(
+    std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+    const std::string& defaultValue, EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getSerializedJsonAssignmentDetails(
+        flagKey, subjectKey, subjectAttributes, defaultValue, traceLevel);
+}
+
+EvaluationResult<std::string> EvaluationSession::getBanditActionDetails(
+    std::string_view flagKey, std::string_view subjectKey,
+    const ContextAttributes& subjectAttributes,
+    const std::map<std::string, ContextAttributes>& actions, const std::string& defaultVariation,
+    EvaluationTraceLevel traceLevel) {
+    return evaluationClient_.getBanditActionDetails(flagKey, subjectKey, subjectAttributes, actions,
+                                                    defaultVariation, traceLevel);
+}
+
+}  // namespace eppoclient
@@ -0,0 +1,187 @@
+#ifndef EVALUATION_SESSION_HPP
+#define EVALUATION_SESSION_HPP
+
+#include <map>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include "application_logger.hpp"
+#include "assignment_result_cache.hpp"
+#include "configuration.hpp"
+#include "evalbandits.hpp"
+#include "evaluation_client.hpp"
+#include "rules.hpp"
+#include "subject_context.hpp"
+
+namespace eppoclient {
+
+/**
+ * EvaluationSession - evaluates flags against one configuration snapshot
+ *
+ * Each EppoClient getter loads the current configuration from the
+ * ConfigurationStore and sets up an EvaluationClient for it. A session, obtained
+ * with EppoClient::session(), does this once: it pins the configuration that was
+ * current when it was created, together with the client's loggers, and evaluates
+ * every flag against that snapshot. Configuration updates made while a session
+ * is in use are seen by the next session.
+ *
+ * A session is meant to be short-lived, typically one per request, so that all
+ * flags evaluated for a request see the same configuration. Sessions share the
+ * client's assignment result cache, if enabled.
+ *
+ * Example usage:
+ * @code
+ * auto session = client.session();
+ *
+ * bool enabled = session.getBooleanAssignment("my-flag", "user-123", attrs, false);
+ * std::string color = session.getStringAssignment("color-flag", "user-123", attrs, "blue");
+ *
+ * // Attributes can also be resolved once for all flags of the session
+ * eppoclient::SubjectContext subject(session.getConfiguration(), "user-123", attrs);
+ * int64_t limit = session.getIntegerAssignment("limit-flag", subject, 10);
+ * @endcode
+ */
+class EvaluationSession {
+public:
+    // Get the configuration the session evaluates flags against
+    const Configuration& getConfiguration() const { return *configuration_; }
+
+    // Get boolean assignment
+    bool getBooleanAssignment(std::string_view flagKey, std::string_view subjectKey,
+                              const Attributes& subjectAttributes, bool defaultValue);
+
+    // Get numeric assignment
+    double getNumericAssignment(std::string_view flagKey, std::string_view subjectKey,
+                                const Attributes& subjectAttributes, double defaultValue);
+
+    // Get integer assignment
+    int64_t getIntegerAssignment(std::string_view flagKey, std::string_view subjectKey,
+                                 const Attributes& subjectAttributes, int64_t defaultValue);
+
+    // Get string assignment
+    std::string getStringAssignment(std::string_view flagKey, std::string_view subjectKey,
+                                    const Attributes& subjectAttributes,
+                                    const std::string& defaultValue);
+
+    // Get JSON assignment
+    nlohmann::json getJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
+                                     const Attributes& subjectAttributes,
+                                     const nlohmann::json& defaultValue);
+
+    // Get serialized JSON assignment (returns stringified JSON)
+    std::string getSerializedJSONAssignment(std::string_view flagKey, std::string_view subjectKey,
+                                            const Attributes& subjectAttributes,
+                                            const std::string& defaultValue);
+
+    // Get bandit action
+    BanditResult getBanditAction(std::string_view flagKey, std::string_view subjectKey,
+                                 const ContextAttributes& subjectAttributes,
+                                 const std::map<std::string, ContextAttributes>& actions,
+                                 const std::string& defaultVariation);
+
+    // Get bandit action from a columnar action table
+    BanditResult getBanditActionColumnar(std::string_view flagKey, std::string_view subjectKey,
+                                         const ContextAttributes& subjectAttributes,
+                                         const BanditActionTable& actions,
+                                         const std::string& defaultVariation);
+
+    // ========== Subject Context Methods ==========
+
+    // Get boolean assignment
+    bool getBooleanAssignment(std::string_view flagKey, const SubjectContext& subject,
+                              bool defaultValue);
+
+    // Get numeric assignment
+    double getNumericAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                double defaultValue);
+
+    // Get integer assignment
+    int64_t getIntegerAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                 int64_t defaultValue);
+
+    // Get string assignment
+    std::string getStringAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                    const std::string& defaultValue);
+
+    // Get JSON assignment
+    nlohmann::json getJSONAssignment(std::string_view flagKey, const SubjectContext& subject,
+                                     const nlohmann::json& defaultValue);
+
+    // ========== Assignment Details Methods ==========
+    // traceLevel sets how much of each flag evaluation the details record
+
+    // Get boolean assignment with details
+    EvaluationResult<bool> getBooleanAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        bool defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Get integer assignment with details
+    EvaluationResult<int64_t> getIntegerAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        int64_t defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Get numeric assignment with details
+    EvaluationResult<double> getNumericAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        double defaultValue, EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Get string assignment with details
+    EvaluationResult<std::string> getStringAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const std::string& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Get JSON assignment with details
+    EvaluationResult<nlohmann::json> getJsonAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const nlohmann::json& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Get serialized JSON assignment with details
+    EvaluationResult<std::string> getSerializedJsonAssignmentDetails(
+        std::string_view flagKey, std::string_view subjectKey, const Attributes& subjectAttributes,
+        const std::string& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Get bandit action with details
+    EvaluationResult<std::string> getBanditActionDetails(
+        std::string_view flagKey, std::string_view subjectKey,
+        const ContextAttributes& subjectAttributes,
+        const std::map<std::string, ContextAttributes>& actions,
+        const std::string& defaultVariation,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS);
+
+    // Generic get assignment details (for advanced use cases)
+    template <typename T>
+    EvaluationResult<T> getAssignmentDetails(
+        VariationType variationType, std::string_view flagKey, std::string_view subjectKey,
+        const Attributes& subjectAttributes, const T& defaultValue,
+        EvaluationTraceLevel traceLevel = EvaluationTraceLevel::ALLOCATIONS) {
+        return evaluationClient_.getAssignmentDetails<T>(variationType, flagKey, subjectKey,
+                                                         subjectAttributes, defaultValue,
+                                                         traceLevel);
+    }
+
+private:
+    friend class EppoClient;
+
+    // Owned here so the evaluation client's references stay valid for the session
+    std::shared_ptr<const Configuration> configuration_;
+    std::shared_ptr<AssignmentLogger> assignmentLogger_;
+    std::shared_ptr<BanditLogger> banditLogger_;
+    std::shared_ptr<ApplicationLogger> applicationLogger_;
+    std::shared_ptr<AssignmentResultCache> assignmentResultCache_;
+
+    EvaluationClient evaluationClient_;
+
+    EvaluationSession(std::shared_ptr<const Configuration> configuration,
+                      std::shared_ptr<AssignmentLogger> assignmentLogger,
+                      std::shared_ptr<BanditLogger> banditLogger,
+                      std::shared_ptr<ApplicationLogger> applicationLogger,
+                      std::shared_ptr<AssignmentResultCache> assignmentResultCache);
+};
+
+}  // namespace eppoclient
+
+#endif  // EVALUATION_SESSION_HPP
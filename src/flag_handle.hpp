@@ -0,0 +1,173 @@
+#ifndef FLAG_HANDLE_HPP
+#define FLAG_HANDLE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "application_logger.hpp"
+#include "config_response.hpp"
+#include "configuration.hpp"
+#include "configuration_store.hpp"
+#include "evalflags.hpp"
+#include "evaluation_client.hpp"
+#include "rules.hpp"
+#include "subject_context.hpp"
+
+namespace eppoclient {
+
+// Internal implementation details (not part of public API)
+namespace internal {
+
+// Variation type of the flags a FlagHandle<T> can evaluate
+template <typename T>
+struct FlagVariationType;
+
+template <>
+struct FlagVariationType<bool> {
+    static constexpr VariationType value = VariationType::BOOLEAN;
+};
+
+template <>
+struct FlagVariationType<int64_t> {
+    static constexpr VariationType value = VariationType::INTEGER;
+};
+
+template <>
+struct FlagVariationType<double> {
+    static constexpr VariationType value = VariationType::NUMERIC;
+};
+
+template <>
+struct FlagVariationType<std::string> {
+    static constexpr VariationType value = VariationType::STRING;
+};
+
+template <>
+struct FlagVariationType<nlohmann::json> {
+    static constexpr VariationType value = VariationType::JSON;
+};
+
+}  // namespace internal
+
+/**
+ * FlagHandle - a flag resolved once for repeated evaluation at hot call sites
+ *
+ * The typed getters of EppoClient look the flag key up in the configuration and
+ * verify the flag's variation type on every call. A FlagHandle remembers the
+ * resolved flag and the result of the type check for the configuration it last
+ * saw, and only resolves the flag again when the ConfigurationStore holds a new
+ * configuration. Evaluating through a handle is otherwise identical to the typed
+ * getters: the same assignment events and application log messages are emitted,
+ * the client's assignment result cache is used if enabled, and the default value
+ * is returned on errors.
+ *
+ * T is one of bool, int64_t, double, std::string or nlohmann::json.
+ *
+ * A handle may be used from multiple threads concurrently.
+ *
+ * Example usage:
+ * @code
+ * auto newCheckout = client.flag<bool>("new-checkout");
+ *
+ * for (const auto& request : requests) {
+ *     if (newCheckout.getAssignment(request.userId, request.attributes, false)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+template <typename T>
+class FlagHandle {
+public:
+    FlagHandle(std::string flagKey, std::shared_ptr<ConfigurationStore> configurationStore,
+               std::shared_ptr<AssignmentLogger> assignmentLogger,
+               std::shared_ptr<BanditLogger> banditLogger,
+               std::shared_ptr<ApplicationLogger> applicationLogger,
+               std::shared_ptr<AssignmentResultCache> assignmentResultCache = nullptr)
+        : flagKey_(std::move(flagKey)),
+          configurationStore_(std::move(configurationStore)),
+          assignmentLogger_(std::move(assignmentLogger)),
+          banditLogger_(std::move(banditLogger)),
+          applicationLogger_(std::move(applicationLogger)),
+          assignmentResultCache_(std::move(assignmentResultCache)) {}
+
+    const std::string& getFlagKey() const { return flagKey_; }
+
+    // Get assignment for a subject
+    T getAssignment(std::string_view subjectKey, const Attributes& subjectAttributes,
+                    const T& defaultValue) const {
+        auto resolved = resolve();
+        EvaluationClient client = evaluationClient(*resolved);
+        auto variation =
+            client.getAssignment(*resolved->configuration, flagKey_, resolved->flag,
+                                 resolved->typeMatches, subjectKey, subjectAttributes,
+                                 variationType_);
+        return client.extractVariation(variation, flagKey_, variationType_, defaultValue);
+    }
+
+    // Get assignment for a subject context
+    T getAssignment(const SubjectContext& subject, const T& defaultValue) const {
+        auto resolved = resolve();
+        EvaluationClient client = evaluationClient(*resolved);
+        auto variation = client.getAssignment(*resolved->configuration, flagKey_, resolved->flag,
+                                              resolved->typeMatches, subject, variationType_);
+        return client.extractVariation(variation, flagKey_, variationType_, defaultValue);
+    }
+
+private:
+    static constexpr VariationType variationType_ = internal::FlagVariationType<T>::value;
+
+    // The flag as resolved against one configuration
+    struct ResolvedFlag {
+        std::shared_ptr<const Configuration> configuration;
+        const FlagConfiguration* flag = nullptr;  // nullptr if not found
+        bool typeMatches = false;
+    };
+
+    std::string flagKey_;
+    std::shared_ptr<ConfigurationStore> configurationStore_;
+    std::shared_ptr<AssignmentLogger> assignmentLogger_;
+    std::shared_ptr<BanditLogger> banditLogger_;
+    std::shared_ptr<ApplicationLogger> applicationLogger_;
+    std::shared_ptr<AssignmentResultCache> assignmentResultCache_;
+
+    // Accessed atomically, as the handle may be used from multiple threads
+    mutable std::shared_ptr<const ResolvedFlag> resolved_;
+
+    // Get the flag resolved against the current configuration, resolving it again
+    // only if the configuration changed since the last call
+    std::shared_ptr<const ResolvedFlag> resolve() const {
+        auto configuration = configurationStore_->getConfiguration();
+        auto resolved = std::atomic_load(&resolved_);
+        if (resolved && resolved->configuration == configuration) {
+            return resolved;
+        }
+
+        auto updated = std::make_shared<ResolvedFlag>();
+        updated->flag = configuration->getFlagConfiguration(flagKey_);
+        updated->typeMatches =
+            updated->flag != nullptr && verifyType(*updated->flag, variationType_);
+        updated->configuration = std::move(configuration);
+
+        resolved = std::move(updated);
+        std::atomic_store(&resolved_, resolved);
+        return resolved;
+    }
+
+    // Evaluation client for the resolved configuration, through the result cache if enabled
+    EvaluationClient evaluationClient(const ResolvedFlag& resolved) const {
+        if (assignmentResultCache_) {
+            return EvaluationClient(resolved.configuration, *assignmentLogger_, *banditLogger_,
+                                    *applicationLogger_, *assignmentResultCache_);
+        }
+        return EvaluationClient(*resolved.configuration, *assignmentLogger_, *banditLogger_,
+                                *applicationLogger_);
+    }
+};
+
+}  // namespace eppoclient
+
+#endif  // FLAG_HANDLE_HPP
@@ -28,6 +28,14 @@ void LruBanditLogger::logBanditAction(const BanditEvent& event) {
     }
 }
 
+bool LruBanditLogger::shouldLogBanditAction(const std::string& flagKey,
+                                            const std::string& subject,
+                                            const std::string& banditKey,
+                                            const std::string& action) {
+    return inner_->shouldLogBanditAction(flagKey, subject, banditKey, action) &&
+           shouldLog(BanditCacheKey(flagKey, subject), BanditCacheValue(banditKey, action));
+}
+
 std::shared_ptr<BanditLogger> NewLruBanditLogger(std::shared_ptr<BanditLogger> logger,
                                                  size_t cacheSize) {
     return std::make_shared<LruBanditLogger>(logger, cacheSize);
@@ -102,6 +102,15 @@ public:
      * @param event The bandit event to log
      */
     void logBanditAction(const BanditEvent& event) override;
+
+    /**
+     * Checks whether a bandit action would be logged, so that the event for a
+     * duplicate is not built. Does not add the action to the cache.
+     *
+     * @return false if the inner logger drops the action or it is a duplicate
+     */
+    bool shouldLogBanditAction(const std::string& flagKey, const std::string& subject,
+                               const std::string& banditKey, const std::string& action) override;
 };
 
 /**
@@ -1,29 +1,94 @@
 #include "rules.hpp"
 #include <semver/semver.hpp>
+#include <charconv>
 #include "config_response.hpp"
 #include "json_utils.hpp"
+#include "subject_context.hpp"
 
 namespace eppoclient {
 namespace internal {
 
-// Rule matches if all conditions match
-bool ruleMatches(const Rule& rule, const Attributes& subjectAttributes, ApplicationLogger* logger) {
-    for (const auto& condition : rule.conditions) {
-        if (!conditionMatches(condition, subjectAttributes, logger)) {
+namespace {
+// Large enough for any int64_t in decimal, including the sign
+constexpr size_t kRegexInputBufferSize = 24;
+
+// Get the text regex patterns are matched against without copying strings or
+// allocating: strings are viewed in place, integers are rendered into buffer.
+// Returns false for value types that never match a pattern.
+bool regexInput(const AttributeValue& subjectValue, char (&buffer)[kRegexInputBufferSize],
+                re2::StringPiece& input);
+
+// Match a condition against the subject's value for its attribute. When a
+// subject context is given, parsed numeric and semver values are memoized in it.
+bool conditionMatchesValue(const Condition& condition, const AttributeValue* subjectValuePtr,
+                           const SubjectContext* subject, ApplicationLogger* logger);
+
+// Evaluate a rule's conditions in its precomputed order, recording outcomes
+// when statistics are collected. Rule matches if all conditions match.
+template <typename Subject>
+bool ruleMatchesInOrder(const Rule& rule, const Subject& subject, ApplicationLogger* logger) {
+    bool ordered = rule.conditionOrder.size() == rule.conditions.size();
+    for (size_t i = 0; i < rule.conditions.size(); ++i) {
+        const Condition& condition = rule.conditions[ordered ? rule.conditionOrder[i] : i];
+        bool matched = conditionMatches(condition, subject, logger);
+        if (condition.statistics) {
+            condition.statistics->evaluations.fetch_add(1, std::memory_order_relaxed);
+            if (!matched) {
+                condition.statistics->failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (!matched) {
             return false;
         }
     }
     return true;
 }
+}  // namespace
+
+bool ruleMatches(const Rule& rule, const Attributes& subjectAttributes, ApplicationLogger* logger) {
+    return ruleMatchesInOrder(rule, subjectAttributes, logger);
+}
 
-// Condition matches based on operator and value comparison
 bool conditionMatches(const Condition& condition, const Attributes& subjectAttributes,
                       ApplicationLogger* logger) {
+    auto it = subjectAttributes.find(condition.attribute);
+    const AttributeValue* subjectValue = it == subjectAttributes.end() ? nullptr : &it->second;
+    return conditionMatches(condition, subjectValue, logger);
+}
+
+bool ruleMatches(const Rule& rule, const SubjectContext& subject, ApplicationLogger* logger) {
+    return ruleMatchesInOrder(rule, subject, logger);
+}
+
+bool anyRuleMatches(const std::vector<Rule>& rules, const std::vector<size_t>& ruleOrder,
+                    const SubjectContext& subject, ApplicationLogger* logger) {
+    bool ordered = ruleOrder.size() == rules.size();
+    for (size_t i = 0; i < rules.size(); ++i) {
+        if (ruleMatches(rules[ordered ? ruleOrder[i] : i], subject, logger)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool conditionMatches(const Condition& condition, const SubjectContext& subject,
+                      ApplicationLogger* logger) {
+    return conditionMatchesValue(condition, subject.getAttribute(condition), &subject, logger);
+}
+
+bool conditionMatches(const Condition& condition, const AttributeValue* subjectValue,
+                      ApplicationLogger* logger) {
+    return conditionMatchesValue(condition, subjectValue, nullptr, logger);
+}
+
+namespace {
+// Condition matches based on operator and value comparison
+bool conditionMatchesValue(const Condition& condition, const AttributeValue* subjectValuePtr,
+                           const SubjectContext* subject, ApplicationLogger* logger) {
     // Handle IS_NULL operator specially
     if (condition.op == Operator::IS_NULL) {
-        auto it = subjectAttributes.find(condition.attribute);
-        bool isNull =
-            (it == subjectAttributes.end() || std::holds_alternative<std::monostate>(it->second));
+        bool isNull = (subjectValuePtr == nullptr ||
+                       std::holds_alternative<std::monostate>(*subjectValuePtr));
 
         // condition.value should be a boolean
         if (!condition.value.is_boolean()) {
@@ -35,12 +100,11 @@ bool conditionMatches(const Condition& condition, const Attributes& subjectAttri
     }
 
     // For all other operators, the attribute must exist
-    auto it = subjectAttributes.find(condition.attribute);
-    if (it == subjectAttributes.end()) {
+    if (subjectValuePtr == nullptr) {
         return false;
     }
 
-    const AttributeValue& subjectValue = it->second;
+    const AttributeValue& subjectValue = *subjectValuePtr;
 
     // Handle different operators
     if (condition.op == Operator::MATCHES) {
@@ -48,11 +112,19 @@ bool conditionMatches(const Condition& condition, const Attributes& subjectAttri
         if (!condition.regexValueValid || !condition.regexValue) {
             // Invalid regex pattern - fail the condition match
             if (logger != nullptr) {
-                logger->error("Invalid regex pattern in MATCHES condition for attribute: " +
-                              condition.attribute);
+                logger->log(LogLevel::Error, [&] {
+                    return "Invalid regex pattern in MATCHES condition for attribute: " +
+                           condition.attribute;
+                });
             }
             return false;
         }
+        if (subject != nullptr) {
+            std::optional<bool> matched = subject->matchesPattern(condition, subjectValue);
+            if (matched.has_value()) {
+                return *matched;
+            }
+        }
         return matches(subjectValue, condition.regexValue);
 
     } else if (condition.op == Operator::NOT_MATCHES) {
@@ -60,11 +132,19 @@ bool conditionMatches(const Condition& condition, const Attributes& subjectAttri
         if (!condition.regexValueValid || !condition.regexValue) {
             // Invalid regex pattern - fail the condition match
             if (logger != nullptr) {
-                logger->error("Invalid regex pattern in NOT_MATCHES condition for attribute: " +
-                              condition.attribute);
+                logger->log(LogLevel::Error, [&] {
+                    return "Invalid regex pattern in NOT_MATCHES condition for attribute: " +
+                           condition.attribute;
+                });
             }
             return false;
         }
+        if (subject != nullptr) {
+            std::optional<bool> matched = subject->matchesPattern(condition, subjectValue);
+            if (matched.has_value()) {
+                return !*matched;
+            }
+        }
         return !matches(subjectValue, condition.regexValue);
 
     } else if (condition.op == Operator::ONE_OF) {
@@ -79,20 +159,33 @@ bool conditionMatches(const Condition& condition, const Attributes& subjectAttri
                condition.op == Operator::LTE || condition.op == Operator::LT) {
         // Try semver comparison first if subject is a string and condition has valid semver
         if (std::holds_alternative<std::string>(subjectValue) && condition.semVerValueValid) {
-            const std::string& subjectValueStr = std::get<std::string>(subjectValue);
-
-            semver::version<> subjectSemVer;
-            auto result = semver::parse(subjectValueStr, subjectSemVer);
-            if (result) {
-                return evaluateSemVerCondition(&subjectSemVer, condition.semVerValue.get(),
-                                               condition.op);
+            // Condition parsing stores a semver::version<> when semVerValueValid is set
+            const auto& conditionSemVer =
+                *static_cast<const semver::version<>*>(condition.semVerValue.get());
+            if (subject != nullptr) {
+                const semver::version<>* subjectSemVer =
+                    subject->getSemVerValue(condition, subjectValue);
+                if (subjectSemVer != nullptr) {
+                    return evaluateSemVerCondition(*subjectSemVer, conditionSemVer, condition.op);
+                }
+            } else {
+                semver::version<> subjectSemVer;
+                auto result = semver::parse(std::get<std::string>(subjectValue), subjectSemVer);
+                if (result) {
+                    return evaluateSemVerCondition(subjectSemVer, conditionSemVer, condition.op);
+                }
             }
             // Failed to parse as semver, fall through to numeric comparison
         }
 
         // Try numeric comparison
-        std::optional<double> subjectValueNumeric = tryToDouble(subjectValue);
-        if (subjectValueNumeric.has_value() && condition.numericValueValid) {
+        if (!condition.numericValueValid) {
+            return false;
+        }
+        std::optional<double> subjectValueNumeric =
+            subject != nullptr ? subject->getNumericValue(condition, subjectValue)
+                               : tryToDouble(subjectValue);
+        if (subjectValueNumeric.has_value()) {
             return evaluateNumericCondition(*subjectValueNumeric, condition.numericValue,
                                             condition.op);
         }
@@ -108,6 +201,29 @@ bool conditionMatches(const Condition& condition, const Attributes& subjectAttri
         return false;
     }
 }
+}  // namespace
+
+// Relative condition costs: IS_NULL and invalid regexes only inspect the
+// attribute, comparisons may parse a number or semantic version, list
+// membership grows with the list, and regexes run a pattern match
+double estimateConditionCost(const Condition& condition) {
+    switch (condition.op) {
+        case Operator::IS_NULL:
+            return 1.0;
+        case Operator::GTE:
+        case Operator::GT:
+        case Operator::LTE:
+        case Operator::LT:
+            return condition.semVerValueValid ? 4.0 : 2.0;
+        case Operator::ONE_OF:
+        case Operator::NOT_ONE_OF:
+            return 3.0 + (condition.value.is_array() ? condition.value.size() : 0);
+        case Operator::MATCHES:
+        case Operator::NOT_MATCHES:
+            return condition.regexValueValid ? 32.0 : 1.0;
+    }
+    return 1.0;
+}
 
 // Convert JSON array to string vector
 std::vector<std::string> convertToStringArray(const nlohmann::json& conditionValue) {
@@ -133,21 +249,53 @@ bool matches(const AttributeValue& subjectValue, const std::shared_ptr<re2::RE2>
         return false;
     }
 
-    std::string v;
+    char buffer[kRegexInputBufferSize];
+    re2::StringPiece input;
+    if (!regexInput(subjectValue, buffer, input)) {
+        return false;
+    }
+
+    // Use RE2::PartialMatch (equivalent to std::regex_search)
+    return re2::RE2::PartialMatch(input, *pattern);
+}
 
+// Multi-pattern matching using a precompiled, unanchored RE2::Set
+std::optional<std::vector<int>> matchPatternSet(const AttributeValue& subjectValue,
+                                                const re2::RE2::Set& patterns) {
+    char buffer[kRegexInputBufferSize];
+    re2::StringPiece input;
+    if (!regexInput(subjectValue, buffer, input)) {
+        // Same as matches(): other types never match
+        return std::vector<int>();
+    }
+
+    std::vector<int> matched;
+    re2::RE2::Set::ErrorInfo errorInfo;
+    if (!patterns.Match(input, &matched, &errorInfo) &&
+        errorInfo.kind != re2::RE2::Set::kNoError) {
+        // e.g. the DFA ran out of memory; callers fall back to matching each pattern
+        return std::nullopt;
+    }
+    return matched;
+}
+
+namespace {
+bool regexInput(const AttributeValue& subjectValue, char (&buffer)[kRegexInputBufferSize],
+                re2::StringPiece& input) {
     if (std::holds_alternative<std::string>(subjectValue)) {
-        v = std::get<std::string>(subjectValue);
+        input = std::get<std::string>(subjectValue);
     } else if (std::holds_alternative<int64_t>(subjectValue)) {
-        v = std::to_string(std::get<int64_t>(subjectValue));
+        auto result =
+            std::to_chars(buffer, buffer + kRegexInputBufferSize, std::get<int64_t>(subjectValue));
+        input = re2::StringPiece(buffer, static_cast<size_t>(result.ptr - buffer));
     } else if (std::holds_alternative<bool>(subjectValue)) {
-        v = std::get<bool>(subjectValue) ? "true" : "false";
+        input = std::get<bool>(subjectValue) ? "true" : "false";
     } else {
         return false;
     }
-
-    // Use RE2::PartialMatch (equivalent to std::regex_search)
-    return re2::RE2::PartialMatch(v, *pattern);
+    return true;
 }
+}  // namespace
 
 // Check if value is in array
 bool isOneOf(const AttributeValue& attributeValue, const std::vector<std::string>& conditionValue) {
@@ -200,17 +348,20 @@ bool isOne(const AttributeValue& attributeValue, const std::string& s) {
 
 // Semantic version comparison
 bool evaluateSemVerCondition(const void* subjectValue, const void* conditionValue, Operator op) {
-    const semver::version<>* subject = static_cast<const semver::version<>*>(subjectValue);
-    const semver::version<>* condition = static_cast<const semver::version<>*>(conditionValue);
+    return evaluateSemVerCondition(*static_cast<const semver::version<>*>(subjectValue),
+                                   *static_cast<const semver::version<>*>(conditionValue), op);
+}
 
+bool evaluateSemVerCondition(const semver::version<>& subjectValue,
+                             const semver::version<>& conditionValue, Operator op) {
     if (op == Operator::GT) {
-        return *subject > *condition;
+        return subjectValue > conditionValue;
     } else if (op == Operator::GTE) {
-        return *subject >= *condition;
+        return subjectValue >= conditionValue;
     } else if (op == Operator::LT) {
-        return *subject < *condition;
+        return subjectValue < conditionValue;
     } else if (op == Operator::LTE) {
-        return *subject <= *condition;
+        return subjectValue <= conditionValue;
     }
 
     // Unknown operator - should not reach here
@@ -2,6 +2,8 @@
 #define RULES_HPP
 
 #include <re2/re2.h>
+#include <re2/set.h>
+#include <semver/semver.hpp>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -17,6 +19,7 @@ namespace eppoclient {
 enum class Operator;
 struct Condition;
 struct Rule;
+class SubjectContext;
 
 // Type aliases for attribute values
 // AttributeValue can be string, int64, double, bool, or null
@@ -37,11 +40,38 @@ bool ruleMatches(const Rule& rule, const Attributes& subjectAttributes,
 bool conditionMatches(const Condition& condition, const Attributes& subjectAttributes,
                       ApplicationLogger* logger = nullptr);
 
+// Check if a rule matches the given subject context
+bool ruleMatches(const Rule& rule, const SubjectContext& subject,
+                 ApplicationLogger* logger = nullptr);
+
+// Check if a condition matches the given subject context
+bool conditionMatches(const Condition& condition, const SubjectContext& subject,
+                      ApplicationLogger* logger = nullptr);
+
+// Check if any rule matches the given subject context, evaluating rules in
+// ruleOrder when it covers every rule and in the given order otherwise
+bool anyRuleMatches(const std::vector<Rule>& rules, const std::vector<size_t>& ruleOrder,
+                    const SubjectContext& subject, ApplicationLogger* logger = nullptr);
+
+// Check if a condition matches the subject's value for its attribute
+// subjectValue is nullptr when the subject does not have the attribute
+bool conditionMatches(const Condition& condition, const AttributeValue* subjectValue,
+                      ApplicationLogger* logger = nullptr);
+
+// Estimate the relative cost of evaluating a condition, used to order
+// conditions and rules so that cheap checks run before expensive ones
+double estimateConditionCost(const Condition& condition);
+
 // Helper functions for condition evaluation
 std::vector<std::string> convertToStringArray(const nlohmann::json& conditionValue);
 
 bool matches(const AttributeValue& subjectValue, const std::shared_ptr<re2::RE2>& pattern);
 
+// Match a subject value against every pattern of a compiled RE2::Set
+// Returns the indexes of the matching patterns, or std::nullopt if matching failed
+std::optional<std::vector<int>> matchPatternSet(const AttributeValue& subjectValue,
+                                                const re2::RE2::Set& patterns);
+
 bool isOneOf(const AttributeValue& attributeValue, const std::vector<std::string>& conditionValue);
 
 bool isOne(const AttributeValue& attributeValue, const std::string& s);
@@ -49,6 +79,8 @@ bool isOne(const AttributeValue& attributeValue, const std::string& s);
 // Semantic version comparison
 // Returns true/false for comparison
 bool evaluateSemVerCondition(const void* subjectValue, const void* conditionValue, Operator op);
+bool evaluateSemVerCondition(const semver::version<>& subjectValue,
+                             const semver::version<>& conditionValue, Operator op);
 
 // Numeric comparison
 // Returns true/false for comparison
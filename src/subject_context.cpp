@@ -0,0 +1,144 @@
+#include "subject_context.hpp"
+#include <semver/semver.hpp>
+
+namespace eppoclient {
+
+SubjectContext::SubjectContext(std::string_view subjectKey, const Attributes& subjectAttributes)
+    : subjectKey_(subjectKey), subjectAttributes_(subjectAttributes), configuration_(nullptr) {}
+
+SubjectContext::SubjectContext(const Configuration& configuration, std::string_view subjectKey,
+                               const Attributes& subjectAttributes)
+    : subjectKey_(subjectKey),
+      subjectAttributes_(subjectAttributes),
+      configuration_(&configuration) {
+    const std::vector<std::string>& attributeNames = configuration.getAttributeNames();
+    resolvedAttributes_.assign(attributeNames.size(), nullptr);
+
+    // Resolve from whichever side is smaller: the subject's attributes or the
+    // attributes referenced by the configuration
+    if (subjectAttributes_.size() <= attributeNames.size()) {
+        for (const auto& [name, value] : subjectAttributes_) {
+            auto id = configuration.getAttributeId(name);
+            if (id.has_value()) {
+                resolvedAttributes_[*id] = &value;
+            }
+        }
+    } else {
+        for (size_t id = 0; id < attributeNames.size(); ++id) {
+            auto it = subjectAttributes_.find(attributeNames[id]);
+            if (it != subjectAttributes_.end()) {
+                resolvedAttributes_[id] = &it->second;
+            }
+        }
+    }
+
+    // Default "id" to the subject key when not provided
+    auto idAttributeId = configuration.getAttributeId("id");
+    if (idAttributeId.has_value() && resolvedAttributes_[*idAttributeId] == nullptr) {
+        resolvedAttributes_[*idAttributeId] = subjectKeyAttribute();
+    }
+}
+
+const AttributeValue* SubjectContext::getAttribute(const Condition& condition) const {
+    if (condition.attributeId.has_value() && *condition.attributeId < resolvedAttributes_.size()) {
+        return resolvedAttributes_[*condition.attributeId];
+    }
+    return getAttribute(condition.attribute);
+}
+
+const AttributeValue* SubjectContext::getAttribute(const std::string& name) const {
+    auto it = subjectAttributes_.find(name);
+    if (it != subjectAttributes_.end()) {
+        return &it->second;
+    }
+
+    if (name == "id") {
+        return subjectKeyAttribute();
+    }
+    return nullptr;
+}
+
+std::optional<double> SubjectContext::getNumericValue(const Condition& condition,
+                                                      const AttributeValue& subjectValue) const {
+    ParsedAttributeValue& parsed = parsedAttribute(condition, subjectValue);
+    if (!parsed.numericParsed) {
+        parsed.numericValue = internal::tryToDouble(subjectValue);
+        parsed.numericParsed = true;
+    }
+    return parsed.numericValue;
+}
+
+const semver::version<>* SubjectContext::getSemVerValue(const Condition& condition,
+                                                        const AttributeValue& subjectValue) const {
+    ParsedAttributeValue& parsed = parsedAttribute(condition, subjectValue);
+    if (!parsed.semVerParsed) {
+        if (std::holds_alternative<std::string>(subjectValue)) {
+            semver::version<> version;
+            if (semver::parse(std::get<std::string>(subjectValue), version)) {
+                parsed.semVerValue = version;
+            }
+        }
+        parsed.semVerParsed = true;
+    }
+    return parsed.semVerValue.has_value() ? &*parsed.semVerValue : nullptr;
+}
+
+std::optional<bool> SubjectContext::matchesPattern(const Condition& condition,
+                                                   const AttributeValue& subjectValue) const {
+    if (configuration_ == nullptr || !condition.patternSetIndex.has_value() ||
+        !condition.attributeId.has_value() ||
+        *condition.attributeId >= resolvedAttributes_.size()) {
+        return std::nullopt;
+    }
+
+    const AttributePatternSet* patternSet =
+        configuration_->getAttributePatternSet(*condition.attributeId);
+    if (patternSet == nullptr || *condition.patternSetIndex >= patternSet->size) {
+        return std::nullopt;
+    }
+
+    ParsedAttributeValue& parsed = parsedAttribute(condition, subjectValue);
+    if (!parsed.patternsMatched) {
+        auto matched = internal::matchPatternSet(subjectValue, *patternSet->patterns);
+        if (matched.has_value()) {
+            parsed.matchedPatterns = std::vector<bool>(patternSet->size, false);
+            for (int index : *matched) {
+                (*parsed.matchedPatterns)[static_cast<size_t>(index)] = true;
+            }
+        }
+        parsed.patternsMatched = true;
+    }
+
+    if (!parsed.matchedPatterns.has_value()) {
+        return std::nullopt;
+    }
+    return (*parsed.matchedPatterns)[*condition.patternSetIndex];
+}
+
+SubjectContext::ParsedAttributeValue& SubjectContext::parsedAttribute(
+    const Condition& condition, const AttributeValue& subjectValue) const {
+    if (condition.attributeId.has_value() && *condition.attributeId < resolvedAttributes_.size()) {
+        if (parsedAttributes_.empty()) {
+            parsedAttributes_.resize(resolvedAttributes_.size());
+        }
+        return parsedAttributes_[*condition.attributeId];
+    }
+
+    // Few attributes are compared per subject, so a linear scan is enough
+    for (auto& [value, parsed] : parsedByValue_) {
+        if (value == &subjectValue) {
+            return parsed;
+        }
+    }
+    parsedByValue_.emplace_back(&subjectValue, ParsedAttributeValue());
+    return parsedByValue_.back().second;
+}
+
+const AttributeValue* SubjectContext::subjectKeyAttribute() const {
+    if (!subjectKeyValue_.has_value()) {
+        subjectKeyValue_ = subjectKey_;
+    }
+    return &*subjectKeyValue_;
+}
+
+}  // namespace eppoclient
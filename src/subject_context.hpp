@@ -0,0 +1,156 @@
+#ifndef SUBJECT_CONTEXT_HPP
+#define SUBJECT_CONTEXT_HPP
+
+#include <semver/semver.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "config_response.hpp"
+#include "configuration.hpp"
+#include "rules.hpp"
+
+namespace eppoclient {
+
+/**
+ * SubjectContext - a subject's key and attributes prepared for rule evaluation
+ *
+ * When created from a Configuration, the subject's attributes are resolved once
+ * into a dense vector indexed by the attribute IDs the Configuration assigned to
+ * every attribute referenced by its conditions. Each condition is then evaluated
+ * with a single array access instead of a hash lookup, which pays off when many
+ * flags are evaluated for the same subject.
+ *
+ * When created without a Configuration, attributes are looked up by name.
+ *
+ * In both cases the "id" attribute defaults to the subject key when not provided.
+ *
+ * Numeric and semantic version values parsed from the subject's attributes are
+ * memoized, so each attribute is parsed at most once per context no matter how
+ * many comparison conditions reference it.
+ *
+ * Because of this memoization, a context is not thread-safe even though its
+ * methods are const: it must not be used from multiple threads at once. Create
+ * one context per thread instead.
+ *
+ * The subject attributes are referenced, not copied, so they must outlive the
+ * context. A context created from a Configuration must only be used to evaluate
+ * flags from that same Configuration.
+ *
+ * Example usage:
+ * @code
+ * eppoclient::SubjectContext subject(config, "user-123", attrs);
+ *
+ * bool enabled = evaluationClient.getBooleanAssignment("my-flag", subject, false);
+ * std::string color = evaluationClient.getStringAssignment("color-flag", subject, "blue");
+ * @endcode
+ */
+class SubjectContext {
+public:
+    // Create a context that looks attributes up by name
+    SubjectContext(std::string_view subjectKey, const Attributes& subjectAttributes);
+
+    // Create a context with attributes resolved against the configuration's attribute IDs
+    SubjectContext(const Configuration& configuration, std::string_view subjectKey,
+                   const Attributes& subjectAttributes);
+
+    // Attributes are referenced, so temporaries are not accepted
+    SubjectContext(std::string_view subjectKey, Attributes&& subjectAttributes) = delete;
+    SubjectContext(const Configuration& configuration, std::string_view subjectKey,
+                   Attributes&& subjectAttributes) = delete;
+
+    // Not copyable or movable: resolved attributes may point into the context itself
+    SubjectContext(const SubjectContext&) = delete;
+    SubjectContext& operator=(const SubjectContext&) = delete;
+    SubjectContext(SubjectContext&&) = delete;
+    SubjectContext& operator=(SubjectContext&&) = delete;
+
+    const std::string& getSubjectKey() const { return subjectKey_; }
+    const Attributes& getSubjectAttributes() const { return subjectAttributes_; }
+
+    // Returns true if attributes were resolved against a configuration
+    bool isResolved() const { return configuration_ != nullptr; }
+
+    // Returns true if attributes were resolved against the given configuration
+    bool isResolvedFor(const Configuration& configuration) const {
+        return configuration_ == &configuration;
+    }
+
+    /**
+     * Get the subject's value for the attribute referenced by a condition.
+     * Uses the condition's attribute ID when resolved, otherwise looks up by name.
+     * Returns nullptr if the subject does not have the attribute.
+     */
+    const AttributeValue* getAttribute(const Condition& condition) const;
+
+    /**
+     * Get the subject's value for an attribute by name.
+     * Returns nullptr if the subject does not have the attribute.
+     */
+    const AttributeValue* getAttribute(const std::string& name) const;
+
+    /**
+     * Get the numeric value of the subject's attribute referenced by a condition.
+     * subjectValue must be the value returned by getAttribute(condition).
+     * Returns std::nullopt if the value cannot be converted to a number.
+     */
+    std::optional<double> getNumericValue(const Condition& condition,
+                                          const AttributeValue& subjectValue) const;
+
+    /**
+     * Get the parsed semantic version of the subject's attribute referenced by a
+     * condition, valid until the next call on this context.
+     * subjectValue must be the value returned by getAttribute(condition).
+     * Returns nullptr if the value is not a string holding a valid semantic version.
+     */
+    const semver::version<>* getSemVerValue(const Condition& condition,
+                                            const AttributeValue& subjectValue) const;
+
+    /**
+     * Check whether the subject's attribute referenced by a MATCHES/NOT_MATCHES
+     * condition matches the condition's pattern, using the attribute's pattern set.
+     * The subject value is matched against all patterns of the set once, and the
+     * result is reused for every condition on the same attribute.
+     * Returns std::nullopt if the condition has no pattern set, in which case the
+     * condition's own pattern must be used.
+     */
+    std::optional<bool> matchesPattern(const Condition& condition,
+                                       const AttributeValue& subjectValue) const;
+
+private:
+    // Lazily parsed forms of a subject attribute value
+    struct ParsedAttributeValue {
+        bool numericParsed = false;
+        bool semVerParsed = false;
+        bool patternsMatched = false;
+        std::optional<double> numericValue;
+        std::optional<semver::version<>> semVerValue;  // std::nullopt if not a valid version
+        std::optional<std::vector<bool>> matchedPatterns;  // std::nullopt if matching failed
+    };
+
+    std::string subjectKey_;
+    const Attributes& subjectAttributes_;
+
+    // Configuration the attributes were resolved against (nullptr when looking up by name)
+    const Configuration* configuration_;
+
+    // Subject key as an attribute value, used when "id" is not provided
+    mutable std::optional<AttributeValue> subjectKeyValue_;
+
+    // Attribute ID -> subject value (nullptr when missing)
+    std::vector<const AttributeValue*> resolvedAttributes_;
+
+    // Parsed values by attribute ID, and by value for attributes without an ID
+    mutable std::vector<ParsedAttributeValue> parsedAttributes_;
+    mutable std::vector<std::pair<const AttributeValue*, ParsedAttributeValue>> parsedByValue_;
+
+    const AttributeValue* subjectKeyAttribute() const;
+    ParsedAttributeValue& parsedAttribute(const Condition& condition,
+                                          const AttributeValue& subjectValue) const;
+};
+
+}  // namespace eppoclient
+
+#endif  // SUBJECT_CONTEXT_HPP
@@ -0,0 +1,59 @@
+#ifndef BETA_FLAG_FIXTURE_HPP
+#define BETA_FLAG_FIXTURE_HPP
+
+#include <catch_amalgamated.hpp>
+#include <string>
+#include <utility>
+#include "../src/config_response.hpp"
+#include "../src/configuration.hpp"
+
+namespace eppoclient {
+namespace test {
+
+// Flags configuration with a single BOOLEAN flag, "beta-flag", that is "on" (and
+// logged) for subjects whose "country" attribute is enabledCountry, and "off"
+// (not logged) for everyone else
+inline std::string makeBetaFlagJson(const std::string& enabledCountry) {
+    return R"({
+    "flags": {
+        "beta-flag": {
+            "key": "beta-flag",
+            "enabled": true,
+            "variationType": "BOOLEAN",
+            "variations": {
+                "on": {"key": "on", "value": true},
+                "off": {"key": "off", "value": false}
+            },
+            "allocations": [
+                {
+                    "key": "beta-users",
+                    "rules": [{"conditions": [
+                        {"attribute": "country", "operator": "ONE_OF", "value": [")" +
+           enabledCountry + R"("]}
+                    ]}],
+                    "splits": [{"variationKey": "on", "shards": []}],
+                    "doLog": true
+                },
+                {
+                    "key": "default",
+                    "splits": [{"variationKey": "off", "shards": []}],
+                    "doLog": false
+                }
+            ],
+            "totalShards": 10000
+        }
+    }
+})";
+}
+
+// Parsed configuration of makeBetaFlagJson()
+inline Configuration makeBetaFlagConfiguration(const std::string& enabledCountry) {
+    auto result = parseConfiguration(makeBetaFlagJson(enabledCountry));
+    REQUIRE(result.hasValue());
+    return std::move(*result.value);
+}
+
+}  // namespace test
+}  // namespace eppoclient
+
+#endif  // BETA_FLAG_FIXTURE_HPP
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -199,6 +200,48 @@ std::vector<BanditTestCase> loadAllBanditTestCases(const std::string& directory)
  * Note: The bandit-flags-v1.json file has a complex structure where bandits are
  * stored as arrays. We flatten this structure before passing to ConfigResponse.
  */
+// Columns of a test subject's actions, for getBanditActionColumnar()
+struct TestActionColumns {
+    std::vector<std::string> keys;
+    std::map<std::string, std::vector<double>> numericValues;
+    std::map<std::string, std::vector<uint8_t>> numericPresent;
+    std::map<std::string, std::vector<std::string>> categoricalValues;
+    std::map<std::string, std::vector<uint8_t>> categoricalPresent;
+
+    explicit TestActionColumns(const std::vector<TestAction>& actions) {
+        const size_t rows = actions.size();
+        for (size_t row = 0; row < rows; ++row) {
+            keys.push_back(actions[row].actionKey);
+            for (const auto& [name, value] : actions[row].attributes.numericAttributes) {
+                numericValues[name].resize(rows);
+                numericPresent[name].resize(rows);
+                numericValues[name][row] = value;
+                numericPresent[name][row] = 1;
+            }
+            for (const auto& [name, value] : actions[row].attributes.categoricalAttributes) {
+                categoricalValues[name].resize(rows);
+                categoricalPresent[name].resize(rows);
+                categoricalValues[name][row] = value;
+                categoricalPresent[name][row] = 1;
+            }
+        }
+    }
+
+    BanditActionTable table() const {
+        BanditActionTable table;
+        table.actionKeys = keys.data();
+        table.actionCount = keys.size();
+        for (const auto& [name, values] : numericValues) {
+            table.numericColumns.push_back({name, values.data(), numericPresent.at(name).data()});
+        }
+        for (const auto& [name, values] : categoricalValues) {
+            table.categoricalColumns.push_back(
+                {name, values.data(), categoricalPresent.at(name).data()});
+        }
+        return table;
+    }
+};
+
 TEST_CASE("UFC Bandit Test Cases - Bandit Action Selection", "[ufc][bandits]") {
     // Load the JSON files directly
     std::string flagsPath = "test/data/ufc/bandit-flags-v1.json";
@@ -324,6 +367,14 @@ TEST_CASE("UFC Bandit Test Cases - Bandit Action Selection", "[ufc][bandits]") {
                         // Verify that no bandit action was logged when action is null
                         CHECK(banditLogger->loggedEvents.size() == 0);
                     }
+
+                    // The same actions in columnar form select the same action
+                    TestActionColumns columns(subject.actions);
+                    BanditResult columnarResult = client.getBanditActionColumnar(
+                        testCase.flag, subject.subjectKey, subject.subjectAttributes,
+                        columns.table(), testCase.defaultValue);
+                    CHECK(columnarResult.variation == result.variation);
+                    CHECK(columnarResult.action == result.action);
                 }
             }
         }
@@ -0,0 +1,115 @@
+#include <catch_amalgamated.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/application_logger.hpp"
+#include "../src/client.hpp"
+#include "../src/configuration.hpp"
+
+using namespace eppoclient;
+
+namespace {
+// Mock application logger recording messages of the enabled levels
+class MockApplicationLogger : public ApplicationLogger {
+public:
+    LogLevel minimumLevel = LogLevel::Debug;
+    std::vector<std::string> debugMessages;
+    std::vector<std::string> infoMessages;
+    std::vector<std::string> warnMessages;
+    std::vector<std::string> errorMessages;
+
+    void debug(const std::string& message) override { debugMessages.push_back(message); }
+
+    void info(const std::string& message) override { infoMessages.push_back(message); }
+
+    void warn(const std::string& message) override { warnMessages.push_back(message); }
+
+    void error(const std::string& message) override { errorMessages.push_back(message); }
+
+    bool isEnabled(LogLevel level) const override { return level >= minimumLevel; }
+};
+
+Configuration makeConfiguration() {
+    auto result = parseConfiguration(R"({
+    "flags": {
+        "beta-flag": {
+            "key": "beta-flag",
+            "enabled": true,
+            "variationType": "BOOLEAN",
+            "variations": {
+                "on": {"key": "on", "value": true}
+            },
+            "allocations": [
+                {
+                    "key": "beta-users",
+                    "rules": [{"conditions": [
+                        {"attribute": "country", "operator": "ONE_OF", "value": ["US"]}
+                    ]}],
+                    "splits": [{"variationKey": "on", "shards": []}],
+                    "doLog": true
+                }
+            ],
+            "totalShards": 10000
+        }
+    }
+})");
+    REQUIRE(result.hasValue());
+    return std::move(*result.value);
+}
+}  // namespace
+
+TEST_CASE("ApplicationLogger::log dispatches to the level's method", "[application-logger]") {
+    MockApplicationLogger logger;
+
+    logger.log(LogLevel::Debug, [] { return "debug message"; });
+    logger.log(LogLevel::Info, [] { return "info message"; });
+    logger.log(LogLevel::Warn, [] { return std::string("warn message"); });
+    logger.log(LogLevel::Error, [] { return std::string("error message"); });
+
+    CHECK(logger.debugMessages == std::vector<std::string>{"debug message"});
+    CHECK(logger.infoMessages == std::vector<std::string>{"info message"});
+    CHECK(logger.warnMessages == std::vector<std::string>{"warn message"});
+    CHECK(logger.errorMessages == std::vector<std::string>{"error message"});
+}
+
+TEST_CASE("ApplicationLogger::log only builds messages of enabled levels", "[application-logger]") {
+    MockApplicationLogger logger;
+    logger.minimumLevel = LogLevel::Warn;
+
+    int built = 0;
+    auto buildMessage = [&] {
+        built++;
+        return std::string("message");
+    };
+
+    logger.log(LogLevel::Info, buildMessage);
+    CHECK(built == 0);
+    CHECK(logger.infoMessages.empty());
+
+    logger.log(LogLevel::Warn, buildMessage);
+    CHECK(built == 1);
+    CHECK(logger.warnMessages.size() == 1);
+
+    NoOpApplicationLogger noOpLogger;
+    CHECK_FALSE(noOpLogger.isEnabled(LogLevel::Error));
+    noOpLogger.log(LogLevel::Error, buildMessage);
+    CHECK(built == 1);
+}
+
+TEST_CASE("EppoClient skips application log messages of disabled levels", "[application-logger]") {
+    auto store = std::make_shared<ConfigurationStore>(makeConfiguration());
+    auto applicationLogger = std::make_shared<MockApplicationLogger>();
+    applicationLogger->minimumLevel = LogLevel::Warn;
+    EppoClient client(store, nullptr, nullptr, applicationLogger);
+
+    Attributes fr = {{"country", std::string("FR")}};
+
+    CHECK(client.getBooleanAssignment("missing-flag", "alice", fr, false) == false);
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, false) == false);
+    CHECK(applicationLogger->infoMessages.empty());
+
+    CHECK(client.getStringAssignment("beta-flag", "alice", fr, "default") == "default");
+    REQUIRE(applicationLogger->warnMessages.size() == 1);
+    CHECK(applicationLogger->warnMessages[0] ==
+          "Failed to verify flag type for: beta-flag (expected: STRING, actual: BOOLEAN)");
+}
@@ -0,0 +1,174 @@
+#include <catch_amalgamated.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/assignment_result_cache.hpp"
+#include "../src/client.hpp"
+#include "../src/configuration.hpp"
+#include "beta_flag_fixture.hpp"
+
+using namespace eppoclient;
+
+namespace {
+// Mock assignment logger
+class MockAssignmentLogger : public AssignmentLogger {
+public:
+    std::vector<AssignmentEvent> loggedEvents;
+
+    void logAssignment(const AssignmentEvent& event) override { loggedEvents.push_back(event); }
+};
+
+// Assignment logger that only counts events, for concurrent use
+class CountingAssignmentLogger : public AssignmentLogger {
+public:
+    std::atomic<int> count{0};
+
+    void logAssignment(const AssignmentEvent&) override { count++; }
+};
+
+std::shared_ptr<const Configuration> makeConfiguration(const std::string& enabledCountry) {
+    return std::make_shared<const Configuration>(test::makeBetaFlagConfiguration(enabledCountry));
+}
+}  // namespace
+
+TEST_CASE("AssignmentResultCache stores results per configuration", "[assignment-result-cache]") {
+    auto config = makeConfiguration("US");
+    const FlagConfiguration* flag = config->getFlagConfiguration("beta-flag");
+    REQUIRE(flag != nullptr);
+
+    AssignmentResultCache cache(100);
+    Attributes us = {{"country", std::string("US")}};
+    Attributes fr = {{"country", std::string("FR")}};
+
+    CHECK(cache.get(config, "beta-flag", "alice", us, VariationType::BOOLEAN) == nullptr);
+
+    EvalResult result;
+    result.value = true;
+    cache.put(config, *flag, "beta-flag", "alice", us, VariationType::BOOLEAN, result);
+    CHECK(cache.size() == 1);
+
+    auto cached = cache.get(config, "beta-flag", "alice", us, VariationType::BOOLEAN);
+    REQUIRE(cached != nullptr);
+    CHECK(std::get<bool>(cached->value) == true);
+
+    // Every part of the key must match
+    CHECK(cache.get(config, "beta-flag", "alice", fr, VariationType::BOOLEAN) == nullptr);
+    CHECK(cache.get(config, "beta-flag", "bob", us, VariationType::BOOLEAN) == nullptr);
+    CHECK(cache.get(config, "other-flag", "alice", us, VariationType::BOOLEAN) == nullptr);
+    CHECK(cache.get(config, "beta-flag", "alice", us, VariationType::STRING) == nullptr);
+
+    // Results of another configuration snapshot are not returned, and do not
+    // invalidate those of this one
+    auto otherConfig = makeConfiguration("US");
+    CHECK(cache.get(otherConfig, "beta-flag", "alice", us, VariationType::BOOLEAN) == nullptr);
+    result.value = false;
+    cache.put(otherConfig, *flag, "beta-flag", "alice", us, VariationType::BOOLEAN, result);
+    CHECK(cache.size() == 2);
+
+    for (int i = 0; i < 3; ++i) {
+        cached = cache.get(config, "beta-flag", "alice", us, VariationType::BOOLEAN);
+        REQUIRE(cached != nullptr);
+        CHECK(std::get<bool>(cached->value) == true);
+        cached = cache.get(otherConfig, "beta-flag", "alice", us, VariationType::BOOLEAN);
+        REQUIRE(cached != nullptr);
+        CHECK(std::get<bool>(cached->value) == false);
+    }
+}
+
+TEST_CASE("AssignmentResultCache does not keep configurations alive",
+          "[assignment-result-cache]") {
+    auto config = makeConfiguration("US");
+    std::weak_ptr<const Configuration> weakConfig = config;
+    const FlagConfiguration* flag = config->getFlagConfiguration("beta-flag");
+    REQUIRE(flag != nullptr);
+
+    AssignmentResultCache cache(100);
+    Attributes us = {{"country", std::string("US")}};
+    EvalResult result;
+    result.value = true;
+    cache.put(config, *flag, "beta-flag", "alice", us, VariationType::BOOLEAN, result);
+
+    config.reset();
+    CHECK(weakConfig.expired());
+
+    // A new snapshot, even at the same address, does not match the expired one
+    auto newConfig = makeConfiguration("US");
+    CHECK(cache.get(newConfig, "beta-flag", "alice", us, VariationType::BOOLEAN) == nullptr);
+}
+
+TEST_CASE("EppoClient serves repeated assignments from the cache", "[assignment-result-cache]") {
+    auto store = std::make_shared<ConfigurationStore>(makeConfiguration("US"));
+    auto assignmentLogger = std::make_shared<MockAssignmentLogger>();
+    EppoClient client(store, assignmentLogger, nullptr, nullptr, 100);
+
+    Attributes us = {{"country", std::string("US")}};
+    Attributes fr = {{"country", std::string("FR")}};
+
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", us, false) == true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", us, false) == true);
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, true) == false);
+
+    // Cached results log the assignment event of their evaluation again
+    REQUIRE(assignmentLogger->loggedEvents.size() == 2);
+    for (const auto& event : assignmentLogger->loggedEvents) {
+        CHECK(event.subject == "alice");
+        CHECK(event.allocation == "beta-users");
+        CHECK(event.variation == "on");
+        CHECK(event.timestamp == assignmentLogger->loggedEvents[0].timestamp);
+    }
+
+    // A mismatched type is not served from the cache
+    CHECK(client.getStringAssignment("beta-flag", "alice", us, "default") == "default");
+}
+
+TEST_CASE("EppoClient cache is invalidated by a new configuration", "[assignment-result-cache]") {
+    auto store = std::make_shared<ConfigurationStore>(makeConfiguration("US"));
+    EppoClient client(store, nullptr, nullptr, nullptr, 100);
+
+    Attributes fr = {{"country", std::string("FR")}};
+
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, true) == false);
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, true) == false);
+
+    store->setConfiguration(makeConfiguration("FR"));
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, false) == true);
+
+    store->setConfiguration(Configuration());
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, false) == false);
+}
+
+TEST_CASE("EppoClient cache is safe to use concurrently", "[assignment-result-cache]") {
+    auto store = std::make_shared<ConfigurationStore>(makeConfiguration("US"));
+    auto assignmentLogger = std::make_shared<CountingAssignmentLogger>();
+    EppoClient client(store, assignmentLogger, nullptr, nullptr, 8);
+
+    const int kThreads = 4;
+    const int kIterations = 500;
+    std::atomic<int> mismatches{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kIterations; ++i) {
+                std::string subjectKey = "subject-" + std::to_string((i + t) % 16);
+                Attributes attributes = {{"country", std::string(i % 2 == 0 ? "US" : "FR")}};
+                bool expected = i % 2 == 0;
+                if (client.getBooleanAssignment("beta-flag", subjectKey, attributes, !expected) !=
+                    expected) {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every "on" assignment is logged, whether evaluated or served from the cache
+    CHECK(mismatches == 0);
+    CHECK(assignmentLogger->count == kThreads * kIterations / 2);
+}
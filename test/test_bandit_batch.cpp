@@ -0,0 +1,189 @@
+#include <catch_amalgamated.hpp>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../src/bandit_batch.hpp"
+
+using namespace eppoclient;
+
+namespace {
+BanditConfiguration makeBanditConfiguration() {
+    BanditConfiguration bandit;
+    bandit.banditKey = "shoe-bandit";
+    bandit.modelVersion = "v7";
+    bandit.modelData.gamma = 1.0;
+    bandit.modelData.defaultActionScore = 0.25;
+    bandit.modelData.actionProbabilityFloor = 0.1;
+
+    BanditNumericAttributeCoefficient age;
+    age.attributeKey = "age";
+    age.coefficient = 0.05;
+    age.missingValueCoefficient = -0.3;
+
+    BanditNumericAttributeCoefficient price;
+    price.attributeKey = "price";
+    price.coefficient = -0.01;
+    price.missingValueCoefficient = 0.1;
+
+    BanditCoefficients nike;
+    nike.actionKey = "nike";
+    nike.intercept = 1.0;
+    nike.subjectNumericCoefficients = {age};
+    nike.actionNumericCoefficients = {price};
+    bandit.modelData.coefficients["nike"] = nike;
+
+    BanditCoefficients adidas;
+    adidas.actionKey = "adidas";
+    adidas.intercept = 1.5;
+    adidas.actionNumericCoefficients = {price};
+    bandit.modelData.coefficients["adidas"] = adidas;
+
+    bandit.modelData.precompute();
+    return bandit;
+}
+
+// Subject keys, attributes and action sets for the contexts of a batch
+struct BatchInput {
+    std::vector<std::string> subjectKeys;
+    std::vector<ContextAttributes> subjectAttributes;
+    std::vector<std::map<std::string, ContextAttributes>> actions;
+
+    explicit BatchInput(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            subjectKeys.push_back("subject-" + std::to_string(i));
+            ContextAttributes subject;
+            subject.numericAttributes["age"] = 18.0 + static_cast<double>(i % 50);
+            subjectAttributes.push_back(subject);
+
+            // Every tenth context has no actions; the others vary in size
+            std::map<std::string, ContextAttributes> actionSet;
+            if (i % 10 != 0) {
+                actionSet["nike"].numericAttributes["price"] = 50.0 + static_cast<double>(i % 70);
+                actionSet["adidas"].numericAttributes["price"] = 80.0;
+                for (size_t j = 0; j < i % 7; ++j) {
+                    actionSet["other-" + std::to_string(j)] = ContextAttributes();
+                }
+            }
+            actions.push_back(actionSet);
+        }
+    }
+
+    std::vector<BanditEvaluationContext> contexts() const {
+        std::vector<BanditEvaluationContext> result;
+        for (size_t i = 0; i < subjectKeys.size(); ++i) {
+            result.emplace_back("shoe-flag", subjectKeys[i], subjectAttributes[i], actions[i]);
+        }
+        return result;
+    }
+};
+}  // namespace
+
+TEST_CASE("evaluateBanditBatch matches evaluateBandit for every context", "[bandit-batch]") {
+    BanditConfiguration bandit = makeBanditConfiguration();
+    BatchInput input(1000);
+    std::vector<BanditEvaluationContext> contexts = input.contexts();
+
+    for (size_t threadCount : {1, 4, 0}) {
+        std::vector<BanditEvaluationDetails> results(contexts.size());
+        evaluateBanditBatch(bandit, contexts.data(), contexts.size(), results.data(), nullptr,
+                            threadCount);
+
+        for (size_t i = 0; i < contexts.size(); ++i) {
+            BanditEvaluationDetails expected = evaluateBandit(bandit.modelData, contexts[i]);
+            CHECK(results[i].subjectKey == expected.subjectKey);
+            CHECK(results[i].actionKey == expected.actionKey);
+            CHECK(results[i].actionScore == expected.actionScore);
+            CHECK(results[i].actionWeight == expected.actionWeight);
+            CHECK(results[i].optimalityGap == expected.optimalityGap);
+        }
+    }
+}
+
+TEST_CASE("evaluateBanditBatch produces events for contexts with actions", "[bandit-batch]") {
+    BanditConfiguration bandit = makeBanditConfiguration();
+    BatchInput input(200);
+    std::vector<BanditEvaluationContext> contexts = input.contexts();
+
+    std::vector<BanditEvaluationDetails> results(contexts.size());
+    std::vector<std::optional<BanditEvent>> events(contexts.size());
+    evaluateBanditBatch(bandit, contexts.data(), contexts.size(), results.data(), events.data(),
+                        3);
+
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        if (contexts[i].actions.empty()) {
+            CHECK_FALSE(events[i].has_value());
+            continue;
+        }
+        REQUIRE(events[i].has_value());
+        CHECK(events[i]->flagKey == "shoe-flag");
+        CHECK(events[i]->banditKey == "shoe-bandit");
+        CHECK(events[i]->modelVersion == "v7");
+        CHECK(events[i]->subject == input.subjectKeys[i]);
+        CHECK(events[i]->action == results[i].actionKey);
+        CHECK(events[i]->actionProbability == results[i].actionWeight);
+        CHECK(events[i]->timestamp == events[1]->timestamp);
+    }
+}
+
+TEST_CASE("evaluateBanditBatch evaluates columnar contexts", "[bandit-batch]") {
+    BanditConfiguration bandit = makeBanditConfiguration();
+
+    std::vector<std::string> keys = {"nike", "adidas"};
+    std::vector<double> prices = {60.0, 80.0};
+    BanditActionTable table;
+    table.actionKeys = keys.data();
+    table.actionCount = keys.size();
+    table.numericColumns.push_back({"price", prices.data()});
+
+    BatchInput input(100);
+    std::vector<BanditColumnarEvaluationContext> contexts;
+    for (size_t i = 0; i < input.subjectKeys.size(); ++i) {
+        contexts.emplace_back("shoe-flag", input.subjectKeys[i], input.subjectAttributes[i],
+                              table);
+    }
+
+    std::vector<BanditEvaluationDetails> results(contexts.size());
+    evaluateBanditBatch(bandit, contexts.data(), contexts.size(), results.data(), nullptr, 2);
+
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        BanditEvaluationDetails expected = evaluateBandit(bandit.modelData, contexts[i]);
+        CHECK(results[i].actionKey == expected.actionKey);
+        CHECK(results[i].actionWeight == expected.actionWeight);
+    }
+}
+
+TEST_CASE("BanditBatchEvaluator reuses its scratch state across batches", "[bandit-batch]") {
+    BanditConfiguration bandit = makeBanditConfiguration();
+    BatchInput input(1000);
+    std::vector<BanditEvaluationContext> contexts = input.contexts();
+
+    // Contexts are shared out dynamically among several workers, so only a single
+    // worker is guaranteed to see the same contexts in every batch
+    BanditBatchEvaluator evaluator(1);
+    CHECK(evaluator.getThreadCount() == 1);
+    std::vector<BanditEvaluationDetails> firstResults(contexts.size());
+    evaluator.evaluate(bandit, contexts.data(), contexts.size(), firstResults.data());
+    size_t capacity = evaluator.getScratchCapacity();
+    CHECK(capacity > 0);
+
+    BanditBatchEvaluator parallelEvaluator(4);
+    CHECK(parallelEvaluator.getThreadCount() == 4);
+    for (int batch = 0; batch < 5; ++batch) {
+        std::vector<BanditEvaluationDetails> results(contexts.size());
+        evaluator.evaluate(bandit, contexts.data(), contexts.size(), results.data());
+        CHECK(evaluator.getScratchCapacity() == capacity);
+
+        std::vector<BanditEvaluationDetails> parallelResults(contexts.size());
+        parallelEvaluator.evaluate(bandit, contexts.data(), contexts.size(),
+                                   parallelResults.data());
+        CHECK(parallelEvaluator.getScratchCapacity() > 0);
+
+        for (size_t i = 0; i < contexts.size(); ++i) {
+            CHECK(results[i].actionKey == firstResults[i].actionKey);
+            CHECK(results[i].actionWeight == firstResults[i].actionWeight);
+            CHECK(parallelResults[i].actionKey == firstResults[i].actionKey);
+            CHECK(parallelResults[i].actionWeight == firstResults[i].actionWeight);
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include <catch_amalgamated.hpp>
 #include <nlohmann/json.hpp>
+#include <string_view>
 #include "../src/configuration.hpp"
+#include "../src/evalflags.hpp"
 
 using namespace eppoclient;
 using json = nlohmann::json;
@@ -179,3 +181,112 @@ TEST_CASE("BanditResponse with multiple bandits", "[configuration]") {
     CHECK(j2["bandits"]["bandit-1"]["modelName"] == "falcon");
     CHECK(j2["bandits"]["bandit-2"]["modelName"] == "contextual");
 }
+
+TEST_CASE("Configuration looks flags up by string_view", "[configuration]") {
+    std::string jsonStr = R"({
+        "flags": {
+            "first-flag": {
+                "key": "first-flag",
+                "enabled": true,
+                "variationType": "BOOLEAN",
+                "variations": {"on": {"key": "on", "value": true}},
+                "allocations": [],
+                "totalShards": 10000
+            },
+            "second-flag": {
+                "key": "second-flag",
+                "enabled": true,
+                "variationType": "BOOLEAN",
+                "variations": {"on": {"key": "on", "value": true}},
+                "allocations": [],
+                "totalShards": 10000
+            }
+        }
+    })";
+
+    auto result = parseConfiguration(jsonStr);
+    REQUIRE(result.hasValue());
+    const Configuration& config = *result.value;
+
+    // A key that is part of a larger buffer
+    const char buffer[] = "first-flag,second-flag";
+    std::string_view first(buffer, 10);
+    std::string_view second(buffer + 11, 11);
+
+    const FlagConfiguration* firstFlag = config.getFlagConfiguration(first);
+    REQUIRE(firstFlag != nullptr);
+    CHECK(firstFlag->key == "first-flag");
+    REQUIRE(config.getFlagConfiguration(second) != nullptr);
+    CHECK(config.getFlagConfiguration(second)->key == "second-flag");
+    CHECK(config.getFlagConfiguration(std::string_view(buffer, 5)) == nullptr);
+
+    // Copies look flags up in their own flags
+    Configuration copy = config;
+    const FlagConfiguration* copiedFlag = copy.getFlagConfiguration(first);
+    REQUIRE(copiedFlag != nullptr);
+    CHECK(copiedFlag != firstFlag);
+    CHECK(copiedFlag->key == "first-flag");
+
+    Configuration assigned;
+    assigned = copy;
+    REQUIRE(assigned.getFlagConfiguration(second) != nullptr);
+    CHECK(assigned.getFlagConfiguration(second) != copy.getFlagConfiguration(second));
+
+    // Moves keep the flags, and so the lookups, valid
+    Configuration moved = std::move(copy);
+    CHECK(moved.getFlagConfiguration(first) == copiedFlag);
+}
+
+TEST_CASE("Configuration condition statistics", "[configuration]") {
+    std::string jsonStr = R"({
+        "flags": {
+            "targeted-flag": {
+                "key": "targeted-flag",
+                "enabled": true,
+                "variationType": "BOOLEAN",
+                "variations": {
+                    "on": {"key": "on", "value": true},
+                    "off": {"key": "off", "value": false}
+                },
+                "allocations": [
+                    {
+                        "key": "targeted",
+                        "rules": [{"conditions": [
+                            {"attribute": "age", "operator": "GTE", "value": 18},
+                            {"attribute": "score", "operator": "GTE", "value": 50}
+                        ]}],
+                        "splits": [{"variationKey": "on", "shards": []}]
+                    }
+                ],
+                "totalShards": 10000
+            }
+        }
+    })";
+
+    auto result = parseConfiguration(jsonStr);
+    REQUIRE(result.hasValue());
+    Configuration config = std::move(*result.value);
+    config.enableConditionStatistics();
+
+    const FlagConfiguration* flag = config.getFlagConfiguration("targeted-flag");
+    REQUIRE(flag != nullptr);
+    const Rule& rule = flag->allocations[0].rules[0];
+    REQUIRE(rule.conditions[0].statistics);
+    CHECK(rule.conditionOrder == std::vector<size_t>{0, 1});
+
+    Attributes attributes = {{"age", int64_t(30)}, {"score", int64_t(10)}};
+    SubjectContext subject(config, "subject", attributes);
+    for (int i = 0; i < 10; ++i) {
+        CHECK_FALSE(evalFlag(*flag, subject).has_value());
+    }
+    CHECK(rule.conditions[1].statistics->failures == 10);
+
+    // Reordering a copy shares the statistics and leaves the original untouched
+    Configuration optimized = config;
+    optimized.reorderConditionsByStatistics();
+    const Rule& optimizedRule =
+        optimized.getFlagConfiguration("targeted-flag")->allocations[0].rules[0];
+    CHECK(optimizedRule.conditionOrder == std::vector<size_t>{1, 0});
+    CHECK(rule.conditionOrder == std::vector<size_t>{0, 1});
+    CHECK(optimizedRule.conditions[1].statistics == rule.conditions[1].statistics);
+}
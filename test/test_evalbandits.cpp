@@ -0,0 +1,465 @@
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../src/bandit_model.hpp"
+#include "../src/bandit_scorer.hpp"
+#include "../src/evalbandits.hpp"
+
+using namespace eppoclient;
+
+namespace {
+BanditNumericAttributeCoefficient numericCoefficient(const std::string& attributeKey,
+                                                     double coefficient,
+                                                     double missingValueCoefficient) {
+    BanditNumericAttributeCoefficient result;
+    result.attributeKey = attributeKey;
+    result.coefficient = coefficient;
+    result.missingValueCoefficient = missingValueCoefficient;
+    return result;
+}
+
+BanditCategoricalAttributeCoefficient categoricalCoefficient(
+    const std::string& attributeKey, double missingValueCoefficient,
+    const std::map<std::string, double>& valueCoefficients) {
+    BanditCategoricalAttributeCoefficient result;
+    result.attributeKey = attributeKey;
+    result.missingValueCoefficient = missingValueCoefficient;
+    result.valueCoefficients = valueCoefficients;
+    return result;
+}
+
+BanditModelData makeModelData() {
+    BanditModelData modelData;
+    modelData.gamma = 1.0;
+    modelData.defaultActionScore = 0.25;
+    modelData.actionProbabilityFloor = 0.1;
+
+    BanditCoefficients nike;
+    nike.actionKey = "nike";
+    nike.intercept = 1.0;
+    nike.subjectNumericCoefficients = {numericCoefficient("age", 0.1, -0.5)};
+    nike.subjectCategoricalCoefficients = {
+        categoricalCoefficient("country", 0.3, {{"US", 0.7}, {"FR", -0.2}})};
+    nike.actionNumericCoefficients = {numericCoefficient("price", -0.01, 0.05),
+                                      numericCoefficient("discount", 0.4, 0.0)};
+    nike.actionCategoricalCoefficients = {
+        categoricalCoefficient("category", -0.1, {{"shoes", 0.6}, {"shirts", 0.2}})};
+    modelData.coefficients["nike"] = nike;
+
+    BanditCoefficients adidas;
+    adidas.actionKey = "adidas";
+    adidas.intercept = 0.8;
+    adidas.subjectNumericCoefficients = {numericCoefficient("age", -0.02, 0.1),
+                                         numericCoefficient("visits", 0.3, 0.0)};
+    adidas.subjectCategoricalCoefficients = {
+        categoricalCoefficient("country", -0.4, {{"DE", 0.9}, {"US", 0.1}}),
+        categoricalCoefficient("device", 0.0, {{"ios", 0.25}})};
+    adidas.actionCategoricalCoefficients = {
+        categoricalCoefficient("category", 0.05, {{"shoes", 0.3}, {"hats", -0.3}})};
+    modelData.coefficients["adidas"] = adidas;
+
+    return modelData;
+}
+
+ContextAttributes makeAttributes(const std::map<std::string, double>& numericAttributes,
+                                 const std::map<std::string, std::string>& categoricalAttributes) {
+    ContextAttributes attributes;
+    attributes.numericAttributes = numericAttributes;
+    attributes.categoricalAttributes = categoricalAttributes;
+    return attributes;
+}
+}  // namespace
+
+TEST_CASE("Compiled bandit model scores actions like scoreAction", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    modelData.precompute();
+    const CompiledBanditModel& model = modelData.compiledModel;
+    REQUIRE(model.valid);
+    REQUIRE(model.actions.size() == 2);
+
+    std::vector<ContextAttributes> subjects = {
+        makeAttributes({{"age", 31.0}, {"visits", 4.0}}, {{"country", "US"}, {"device", "ios"}}),
+        makeAttributes({{"age", 18.5}}, {{"country", "JP"}}),  // Unknown value
+        makeAttributes({}, {}),                                 // Everything missing
+        makeAttributes({{"unused", 1.0}}, {{"unused", "x"}}),   // Attributes without coefficients
+    };
+    std::vector<ContextAttributes> actions = {
+        makeAttributes({{"price", 120.0}, {"discount", 0.15}}, {{"category", "shoes"}}),
+        makeAttributes({{"price", 35.0}}, {{"category", "hats"}}),
+        makeAttributes({}, {{"category", "socks"}}),
+    };
+
+    internal::ResolvedBanditAttributes resolvedSubject;
+    internal::ResolvedBanditAttributes resolvedAction;
+    for (const auto& subject : subjects) {
+        internal::resolveBanditAttributes(model.subjectNumericAttributes,
+                                          model.subjectCategoricalAttributes, subject,
+                                          resolvedSubject);
+        for (const auto& action : actions) {
+            internal::resolveBanditAttributes(model.actionNumericAttributes,
+                                              model.actionCategoricalAttributes, action,
+                                              resolvedAction);
+            for (const auto& [actionKey, actionId] : model.actionIds) {
+                // Scores must be bit-identical, not merely close
+                CHECK(internal::scoreCompiledAction(model.actions[actionId], resolvedSubject,
+                                                    resolvedAction) ==
+                      scoreAction(modelData, subject, actionKey, action));
+            }
+        }
+    }
+}
+
+TEST_CASE("Compiled categorical terms only store their own values", "[evalbandits]") {
+    // Every action has a coefficient for its own brand value only
+    BanditModelData modelData = makeModelData();
+    for (int i = 0; i < 100; ++i) {
+        std::string brand = "brand-" + std::to_string(i);
+        BanditCoefficients coefficients;
+        coefficients.actionKey = brand;
+        coefficients.actionCategoricalCoefficients = {
+            categoricalCoefficient("brand", -0.5, {{brand, static_cast<double>(i)}})};
+        modelData.coefficients[brand] = coefficients;
+    }
+    modelData.precompute();
+    const CompiledBanditModel& model = modelData.compiledModel;
+    REQUIRE(model.valid);
+
+    uint32_t brandId = model.actionCategoricalAttributes.ids.at("brand");
+    CHECK(model.actionCategoricalAttributes.valueIds[brandId].size() == 100);
+    const auto& terms = model.actions[model.actionIds.at("brand-7")].actionCategorical;
+    CHECK(terms.valueIds.size() == 1);
+    CHECK(terms.scores.size() == 1);
+
+    ContextAttributes subject;
+    internal::ResolvedBanditAttributes resolvedSubject;
+    internal::ResolvedBanditAttributes resolvedAction;
+    internal::resolveBanditAttributes(model.subjectNumericAttributes,
+                                      model.subjectCategoricalAttributes, subject,
+                                      resolvedSubject);
+    for (const std::string value : {"brand-7", "brand-8", "unknown"}) {
+        ContextAttributes action = makeAttributes({}, {{"brand", value}});
+        internal::resolveBanditAttributes(model.actionNumericAttributes,
+                                          model.actionCategoricalAttributes, action,
+                                          resolvedAction);
+        CHECK(internal::scoreCompiledAction(model.actions[model.actionIds.at("brand-7")],
+                                            resolvedSubject, resolvedAction) ==
+              scoreAction(modelData, subject, "brand-7", action));
+    }
+}
+
+TEST_CASE("evaluateBandit selects the same action with a compiled model", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    BanditModelData compiledModelData = makeModelData();
+    compiledModelData.precompute();
+
+    std::map<std::string, ContextAttributes> actions;
+    actions["nike"] =
+        makeAttributes({{"price", 120.0}, {"discount", 0.15}}, {{"category", "shoes"}});
+    actions["adidas"] = makeAttributes({{"price", 35.0}}, {{"category", "hats"}});
+    actions["reebok"] = makeAttributes({}, {});  // No coefficients: default score
+
+    for (int i = 0; i < 50; ++i) {
+        std::string subjectKey = "subject-" + std::to_string(i);
+        ContextAttributes subjectAttributes =
+            makeAttributes({{"age", 20.0 + i}}, {{"country", i % 2 == 0 ? "US" : "DE"}});
+        BanditEvaluationContext context("shoe-bandit", subjectKey, subjectAttributes, actions);
+
+        BanditEvaluationDetails expected = evaluateBandit(modelData, context);
+        BanditEvaluationDetails actual = evaluateBandit(compiledModelData, context);
+        CHECK(actual.actionKey == expected.actionKey);
+        CHECK(actual.actionScore == expected.actionScore);
+        CHECK(actual.actionWeight == expected.actionWeight);
+        CHECK(actual.optimalityGap == expected.optimalityGap);
+    }
+}
+
+TEST_CASE("accumulateProducts matches the scalar implementation bit for bit", "[evalbandits]") {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+
+    for (size_t lanes : {1, 2, 3, 4, 5, 7, 8, 9, 64, 501}) {
+        const size_t rows = 6;
+        std::vector<double> coefficients(rows * lanes);
+        std::vector<double> values(rows * lanes);
+        for (size_t i = 0; i < rows * lanes; ++i) {
+            coefficients[i] = distribution(random);
+            values[i] = distribution(random);
+        }
+
+        std::vector<double> expected(lanes, 0.5);
+        std::vector<double> actual(lanes, 0.5);
+        internal::accumulateProductsScalar(coefficients.data(), values.data(), rows, lanes,
+                                           expected.data());
+        internal::accumulateProducts(coefficients.data(), values.data(), rows, lanes,
+                                     actual.data());
+        CHECK(std::memcmp(expected.data(), actual.data(), lanes * sizeof(double)) == 0);
+    }
+}
+
+TEST_CASE("BanditActionScorer scores actions like scoreAction", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    modelData.precompute();
+
+    ContextAttributes subject =
+        makeAttributes({{"age", 27.0}, {"visits", 12.0}}, {{"country", "DE"}});
+
+    // Enough actions to fill several SIMD registers, with and without coefficients
+    std::vector<std::pair<std::string, ContextAttributes>> actions;
+    for (int i = 0; i < 23; ++i) {
+        std::string actionKey = i % 5 == 4 ? "unknown-" + std::to_string(i)
+                                           : (i % 2 == 0 ? "nike" : "adidas");
+        ContextAttributes attributes;
+        if (i % 3 != 0) {
+            attributes.numericAttributes["price"] = 10.0 * i + 0.99;
+        }
+        if (i % 4 != 0) {
+            attributes.categoricalAttributes["category"] = i % 2 == 0 ? "shoes" : "hats";
+        }
+        actions.emplace_back(actionKey, attributes);
+    }
+
+    internal::BanditActionScorer scorer;
+    scorer.reset(modelData.compiledModel, subject);
+    for (const auto& [actionKey, attributes] : actions) {
+        scorer.addAction(actionKey, attributes);
+    }
+    std::vector<double> scores;
+    scorer.score(modelData.defaultActionScore, scores);
+
+    REQUIRE(scores.size() == actions.size());
+    for (size_t i = 0; i < actions.size(); ++i) {
+        CHECK(scores[i] == scoreAction(modelData, subject, actions[i].first, actions[i].second));
+    }
+}
+
+TEST_CASE("evaluateBandit results do not depend on earlier evaluations", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    modelData.precompute();
+
+    ContextAttributes subjectAttributes = makeAttributes({{"age", 30.0}}, {{"country", "US"}});
+    std::map<std::string, ContextAttributes> smallActions;
+    smallActions["nike"] = makeAttributes({{"price", 80.0}}, {{"category", "shoes"}});
+    smallActions["adidas"] = makeAttributes({}, {{"category", "shoes"}});
+
+    std::map<std::string, ContextAttributes> largeActions = smallActions;
+    for (int i = 0; i < 100; ++i) {
+        largeActions["action-" + std::to_string(i)] = makeAttributes({{"price", 1.0 * i}}, {});
+    }
+
+    BanditEvaluationContext small("shoe-bandit", "alice", subjectAttributes, smallActions);
+    BanditEvaluationContext large("shoe-bandit", "bob", subjectAttributes, largeActions);
+
+    BanditEvaluationDetails before = evaluateBandit(modelData, small);
+    evaluateBandit(modelData, large);
+    BanditEvaluationDetails after = evaluateBandit(modelData, small);
+
+    CHECK(after.actionKey == before.actionKey);
+    CHECK(after.actionScore == before.actionScore);
+    CHECK(after.actionWeight == before.actionWeight);
+    CHECK(after.optimalityGap == before.optimalityGap);
+    CHECK(after.actionAttributes.numericAttributes == before.actionAttributes.numericAttributes);
+}
+
+TEST_CASE("evaluateBandit selects no action from an empty action set", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    modelData.precompute();
+
+    ContextAttributes subjectAttributes;
+    std::map<std::string, ContextAttributes> actions;
+    BanditEvaluationContext context("shoe-bandit", "alice", subjectAttributes, actions);
+
+    BanditEvaluationDetails details = evaluateBandit(modelData, context);
+    CHECK(details.flagKey == "shoe-bandit");
+    CHECK(details.subjectKey == "alice");
+    CHECK(details.actionKey.empty());
+}
+
+TEST_CASE("evaluateBandit selects the same action from a columnar action table", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    BanditModelData compiledModelData = makeModelData();
+    compiledModelData.precompute();
+
+    // Rows out of key order, with missing values, a repeated key and an unused column
+    std::vector<std::string> keys = {"reebok", "nike", "adidas", "puma", "nike"};
+    std::vector<double> prices = {60.0, 120.0, 35.0, 80.0, 1.0};
+    std::vector<uint8_t> pricePresent = {1, 1, 1, 0, 1};
+    std::vector<double> discounts = {0.0, 0.15, 0.3, 0.5, 0.0};
+    std::vector<std::string> categories = {"shoes", "shoes", "hats", "socks", "hats"};
+    std::vector<uint8_t> categoryPresent = {1, 1, 1, 1, 0};
+    std::vector<std::string> colors = {"red", "black", "white", "blue", "green"};
+
+    BanditActionTable table;
+    table.actionKeys = keys.data();
+    table.actionCount = keys.size();
+    table.numericColumns.push_back({"price", prices.data(), pricePresent.data()});
+    table.numericColumns.push_back({"discount", discounts.data()});
+    table.categoricalColumns.push_back({"category", categories.data(), categoryPresent.data()});
+    table.categoricalColumns.push_back({"color", colors.data()});
+
+    // The equivalent action map keeps the first row of a repeated key
+    std::map<std::string, ContextAttributes> actions;
+    for (size_t row = 0; row < table.actionCount; ++row) {
+        actions.emplace(keys[row], table.actionAttributes(row));
+    }
+    CHECK(actions["puma"].numericAttributes.count("price") == 0);
+    CHECK(actions["nike"].numericAttributes["price"] == 120.0);
+
+    for (int i = 0; i < 50; ++i) {
+        std::string subjectKey = "subject-" + std::to_string(i);
+        ContextAttributes subjectAttributes =
+            makeAttributes({{"age", 20.0 + i}}, {{"country", i % 2 == 0 ? "US" : "DE"}});
+        BanditEvaluationContext context("shoe-bandit", subjectKey, subjectAttributes, actions);
+        BanditColumnarEvaluationContext columnarContext("shoe-bandit", subjectKey,
+                                                        subjectAttributes, table);
+
+        for (const BanditModelData* data : {&modelData, &compiledModelData}) {
+            BanditEvaluationDetails expected = evaluateBandit(*data, context);
+            BanditEvaluationDetails actual = evaluateBandit(*data, columnarContext);
+            CHECK(actual.actionKey == expected.actionKey);
+            CHECK(actual.actionScore == expected.actionScore);
+            CHECK(actual.actionWeight == expected.actionWeight);
+            CHECK(actual.optimalityGap == expected.optimalityGap);
+            CHECK(actual.actionAttributes.numericAttributes ==
+                  expected.actionAttributes.numericAttributes);
+            CHECK(actual.actionAttributes.categoricalAttributes ==
+                  expected.actionAttributes.categoricalAttributes);
+        }
+    }
+}
+
+TEST_CASE("evaluateBandit returns the action distribution and top actions", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    modelData.precompute();
+
+    std::map<std::string, ContextAttributes> actions;
+    for (int i = 0; i < 12; ++i) {
+        std::string actionKey = (i % 3 == 0 ? "nike-" : "adidas-") + std::to_string(i);
+        actions[actionKey] = makeAttributes({{"price", 10.0 * i}}, {{"category", "shoes"}});
+    }
+    // Scored with the coefficients of the existing actions
+    actions["nike"] = makeAttributes({{"price", 50.0}}, {{"category", "shoes"}});
+    actions["adidas"] = makeAttributes({}, {{"category", "hats"}});
+
+    ContextAttributes subjectAttributes = makeAttributes({{"age", 40.0}}, {{"country", "US"}});
+    BanditEvaluationContext context("shoe-bandit", "alice", subjectAttributes, actions);
+
+    BanditActionDistribution distribution;
+    BanditEvaluationDetails details = evaluateBandit(modelData, context, 3, distribution);
+    BanditEvaluationDetails expected = evaluateBandit(modelData, context);
+    CHECK(details.actionKey == expected.actionKey);
+    CHECK(details.actionWeight == expected.actionWeight);
+
+    REQUIRE(distribution.actionKeys.size() == actions.size());
+    REQUIRE(distribution.scores.size() == actions.size());
+    REQUIRE(distribution.weights.size() == actions.size());
+    double totalWeight = 0.0;
+    size_t i = 0;
+    for (const auto& [actionKey, attributes] : actions) {
+        CHECK(distribution.actionKeys[i] == actionKey);
+        CHECK(distribution.scores[i] ==
+              scoreAction(modelData, subjectAttributes, actionKey, attributes));
+        if (actionKey == details.actionKey) {
+            CHECK(distribution.weights[i] == details.actionWeight);
+        }
+        totalWeight += distribution.weights[i];
+        ++i;
+    }
+    CHECK(totalWeight == Catch::Approx(1.0));
+
+    // Many actions share the default score; ties are ranked in key order
+    std::vector<size_t> ranking(actions.size());
+    for (size_t j = 0; j < ranking.size(); ++j) {
+        ranking[j] = j;
+    }
+    std::stable_sort(ranking.begin(), ranking.end(), [&distribution](size_t a1, size_t a2) {
+        return distribution.scores[a1] > distribution.scores[a2];
+    });
+    ranking.resize(3);
+    CHECK(distribution.topActions == ranking);
+
+    // All actions can be ranked, and an empty action set clears the distribution
+    evaluateBandit(modelData, context, actions.size() + 5, distribution);
+    CHECK(distribution.topActions.size() == actions.size());
+
+    std::map<std::string, ContextAttributes> noActions;
+    BanditEvaluationContext emptyContext("shoe-bandit", "alice", subjectAttributes, noActions);
+    evaluateBandit(modelData, emptyContext, 3, distribution);
+    CHECK(distribution.actionKeys.empty());
+    CHECK(distribution.topActions.empty());
+}
+
+TEST_CASE("Actions with identical subject coefficients share subject scores", "[evalbandits]") {
+    BanditModelData modelData = makeModelData();
+    // Same subject coefficients as nike, different action coefficients
+    BanditCoefficients puma = modelData.coefficients["nike"];
+    puma.actionKey = "puma";
+    puma.intercept = 0.2;
+    puma.actionNumericCoefficients = {numericCoefficient("price", 0.02, 0.0)};
+    modelData.coefficients["puma"] = puma;
+    // Same coefficients as nike except for the sign of a zero coefficient
+    BanditCoefficients reebok = modelData.coefficients["nike"];
+    reebok.actionKey = "reebok";
+    reebok.subjectNumericCoefficients = {numericCoefficient("age", 0.1, -0.0)};
+    modelData.coefficients["reebok"] = reebok;
+    modelData.precompute();
+
+    const CompiledBanditModel& model = modelData.compiledModel;
+    auto subjectTermsId = [&model](const std::string& actionKey) {
+        return model.actions[model.actionIds.at(actionKey)].subjectTermsId;
+    };
+    CHECK(subjectTermsId("puma") == subjectTermsId("nike"));
+    CHECK(subjectTermsId("adidas") != subjectTermsId("nike"));
+    CHECK(subjectTermsId("reebok") != subjectTermsId("nike"));
+
+    std::map<std::string, ContextAttributes> actions;
+    for (const std::string actionKey : {"adidas", "nike", "puma", "reebok", "unknown"}) {
+        actions[actionKey] = makeAttributes({{"price", 42.0}}, {{"category", "shoes"}});
+    }
+    for (const ContextAttributes& subject :
+         {makeAttributes({{"age", 33.0}, {"visits", 2.0}}, {{"country", "FR"}}),
+          makeAttributes({}, {{"device", "ios"}})}) {
+        internal::BanditActionScorer scorer;
+        scorer.reset(model, subject);
+        for (const auto& [actionKey, attributes] : actions) {
+            scorer.addAction(actionKey, attributes);
+        }
+        std::vector<double> scores;
+        scorer.score(modelData.defaultActionScore, scores);
+
+        size_t lane = 0;
+        for (const auto& [actionKey, attributes] : actions) {
+            CHECK(scores[lane++] == scoreAction(modelData, subject, actionKey, attributes));
+        }
+    }
+}
+
+TEST_CASE("createBanditEvent moves attributes out of finished evaluations", "[evalbandits]") {
+    BanditEvaluationDetails evaluation;
+    evaluation.flagKey = "shoe-flag";
+    evaluation.subjectKey = "alice";
+    evaluation.actionKey = "nike";
+    evaluation.actionWeight = 0.75;
+    evaluation.optimalityGap = 0.5;
+    evaluation.subjectAttributes = makeAttributes({{"age", 30.0}}, {{"country", "US"}});
+    evaluation.actionAttributes = makeAttributes({{"price", 80.0}}, {{"category", "shoes"}});
+
+    BanditEvent copied = createBanditEvent("shoe-flag", "alice", "shoe-bandit", "v1", evaluation,
+                                           "2024-01-15T10:30:00Z");
+    BanditEvent moved = createBanditEvent("shoe-flag", "alice", "shoe-bandit", "v1",
+                                          std::move(evaluation), "2024-01-15T10:30:00Z");
+
+    CHECK(moved.action == copied.action);
+    CHECK(moved.actionProbability == copied.actionProbability);
+    CHECK(moved.optimalityGap == copied.optimalityGap);
+    CHECK(moved.metaData == copied.metaData);
+    CHECK(moved.subjectNumericAttributes == copied.subjectNumericAttributes);
+    CHECK(moved.subjectCategoricalAttributes == copied.subjectCategoricalAttributes);
+    CHECK(moved.actionNumericAttributes == copied.actionNumericAttributes);
+    CHECK(moved.actionCategoricalAttributes == copied.actionCategoricalAttributes);
+    CHECK(moved.actionCategoricalAttributes.at("category") == "shoes");
+}
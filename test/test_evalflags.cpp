@@ -0,0 +1,227 @@
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "../src/config_response.hpp"
+#include "../src/evalflags.hpp"
+
+using namespace eppoclient;
+
+namespace {
+// Reference split selection: the first split whose shards all match
+const Split* linearSelectSplit(const Allocation& allocation, const std::string& subjectKey,
+                               int64_t totalShards) {
+    for (const auto& split : allocation.splits) {
+        if (splitMatches(split, subjectKey, totalShards)) {
+            return &split;
+        }
+    }
+    return nullptr;
+}
+
+Split makeSplit(const std::string& variationKey, std::vector<Shard> shards) {
+    Split split;
+    split.variationKey = variationKey;
+    split.shards = std::move(shards);
+    return split;
+}
+}  // namespace
+
+TEST_CASE("Split index selects the same split as a linear scan", "[evalflags]") {
+    const int64_t totalShards = 10000;
+
+    SECTION("Layered traffic and variation shards") {
+        Allocation allocation;
+        allocation.splits.push_back(
+            makeSplit("control", {Shard{"traffic", {{0, 5000}}}, Shard{"variant", {{0, 5000}}}}));
+        allocation.splits.push_back(makeSplit(
+            "treatment", {Shard{"traffic", {{0, 5000}}}, Shard{"variant", {{5000, 10000}}}}));
+        allocation.precompute();
+        REQUIRE(allocation.splitIndex.valid);
+        CHECK(allocation.splitIndex.salts.size() == 2);
+
+        for (int i = 0; i < 2000; ++i) {
+            std::string subjectKey = "subject-" + std::to_string(i);
+            CHECK(selectSplit(allocation, subjectKey, totalShards) ==
+                  linearSelectSplit(allocation, subjectKey, totalShards));
+        }
+    }
+
+    SECTION("Many ranges, overlapping splits, and catch-all split") {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> shardDist(0, totalShards);
+
+        Allocation allocation;
+        for (int s = 0; s < 70; ++s) {
+            Shard shard{s % 2 == 0 ? "salt-a" : "salt-b", {}};
+            for (int r = 0; r < 10; ++r) {
+                int a = shardDist(rng);
+                int b = shardDist(rng);
+                shard.ranges.push_back(ShardRange{std::min(a, b), std::max(a, b)});
+            }
+            allocation.splits.push_back(makeSplit("split-" + std::to_string(s), {shard}));
+        }
+        allocation.splits.push_back(makeSplit("everyone", {}));
+        allocation.precompute();
+        REQUIRE(allocation.splitIndex.valid);
+        CHECK(allocation.splitIndex.words == 2);
+
+        for (int i = 0; i < 2000; ++i) {
+            std::string subjectKey = "subject-" + std::to_string(i);
+            const Split* split = selectSplit(allocation, subjectKey, totalShards);
+            REQUIRE(split != nullptr);
+            CHECK(split == linearSelectSplit(allocation, subjectKey, totalShards));
+        }
+    }
+
+    SECTION("Shards without ranges never match") {
+        Allocation allocation;
+        allocation.splits.push_back(makeSplit("nobody", {Shard{"salt", {}}}));
+        allocation.precompute();
+
+        CHECK(selectSplit(allocation, "subject", totalShards) == nullptr);
+    }
+
+    SECTION("Allocation without a precomputed index") {
+        Allocation allocation;
+        allocation.splits.push_back(makeSplit("half", {Shard{"salt", {{0, 5000}}}}));
+        REQUIRE_FALSE(allocation.splitIndex.valid);
+
+        for (int i = 0; i < 100; ++i) {
+            std::string subjectKey = "subject-" + std::to_string(i);
+            CHECK(selectSplit(allocation, subjectKey, totalShards) ==
+                  linearSelectSplit(allocation, subjectKey, totalShards));
+        }
+    }
+}
+
+TEST_CASE("evalFlagDetails evaluates each allocation once", "[evalflags]") {
+    Condition condition;
+    condition.op = Operator::ONE_OF;
+    condition.attribute = "country";
+    condition.value = nlohmann::json::array({"US"});
+    condition.statistics = std::make_shared<ConditionStatistics>();
+
+    Rule rule;
+    rule.conditions.push_back(condition);
+
+    Allocation allocation;
+    allocation.key = "us-only";
+    allocation.rules.push_back(rule);
+    allocation.splits.push_back(makeSplit("on", {}));
+
+    FlagConfiguration flag;
+    flag.key = "details-flag";
+    flag.enabled = true;
+    flag.variationType = VariationType::BOOLEAN;
+    flag.variations["on"] = Variation{"on", true};
+    flag.allocations.push_back(allocation);
+    flag.precompute();
+
+    const auto& statistics = flag.allocations[0].rules[0].conditions[0].statistics;
+    REQUIRE(statistics);
+
+    Attributes attributes = {{"country", std::string("US")}};
+    EvalResultWithDetails result = evalFlagDetails(flag, "subject", attributes);
+
+    CHECK(result.details.flagEvaluationCode == FlagEvaluationCode::MATCH);
+    REQUIRE(result.details.allocations.size() == 1);
+    CHECK(result.details.allocations[0].allocationEvaluationCode ==
+          AllocationEvaluationCode::MATCH);
+    CHECK(result.details.variationKey == std::optional<std::string>("on"));
+    CHECK(statistics->evaluations == 1);
+}
+
+TEST_CASE("evalFlagDetails records a full trace on request", "[evalflags]") {
+    Condition country;
+    country.op = Operator::ONE_OF;
+    country.attribute = "country";
+    country.value = nlohmann::json::array({"US"});
+    Condition age;
+    age.op = Operator::GTE;
+    age.attribute = "age";
+    age.value = 18;
+
+    Rule usAdults;
+    usAdults.conditions = {country, age};
+    Rule anyAdult;
+    anyAdult.conditions = {age};
+
+    Allocation allocation;
+    allocation.key = "adults";
+    allocation.rules = {usAdults, anyAdult};
+    allocation.splits.push_back(makeSplit("off", {Shard{"salt", {}}}));
+    allocation.splits.push_back(makeSplit("on", {Shard{"salt", {{0, 10000}}}}));
+
+    FlagConfiguration flag;
+    flag.key = "trace-flag";
+    flag.enabled = true;
+    flag.variationType = VariationType::BOOLEAN;
+    flag.variations["on"] = Variation{"on", true};
+    flag.variations["off"] = Variation{"off", false};
+    flag.allocations.push_back(allocation);
+    flag.precompute();
+
+    Attributes attributes = {{"country", std::string("FR")}, {"age", int64_t(30)}};
+    SubjectContext subject("subject", attributes);
+
+    SECTION("Allocation trace does not record rules or splits") {
+        EvalResultWithDetails result = evalFlagDetails(flag, subject);
+        REQUIRE(result.details.allocations.size() == 1);
+        CHECK(result.details.allocations[0].evaluatedRules.empty());
+        CHECK(result.details.allocations[0].evaluatedSplits.empty());
+    }
+
+    SECTION("Full trace records rules, conditions, splits and shards") {
+        EvalResultWithDetails result =
+            evalFlagDetails(flag, subject, nullptr, EvaluationTraceLevel::FULL);
+        CHECK(result.details.flagEvaluationCode == FlagEvaluationCode::MATCH);
+        CHECK(result.details.variationKey == std::optional<std::string>("on"));
+        REQUIRE(result.details.allocations.size() == 1);
+        const auto& details = result.details.allocations[0];
+        CHECK(details.allocationEvaluationCode == AllocationEvaluationCode::MATCH);
+
+        // Rules are traced in configuration order until one matches
+        REQUIRE(details.evaluatedRules.size() == 2);
+        CHECK_FALSE(details.evaluatedRules[0].matched);
+        REQUIRE(details.evaluatedRules[0].conditions.size() == 2);
+        CHECK(details.evaluatedRules[0].conditions[0].condition["attribute"] == "country");
+        CHECK(details.evaluatedRules[0].conditions[0].attributeValue ==
+              std::optional<std::variant<std::string, int64_t, double, bool>>("FR"));
+        CHECK_FALSE(details.evaluatedRules[0].conditions[0].matched);
+        CHECK(details.evaluatedRules[0].conditions[1].matched);
+        CHECK(details.evaluatedRules[1].matched);
+
+        // Splits are traced in order until one matches
+        REQUIRE(details.evaluatedSplits.size() == 2);
+        CHECK(details.evaluatedSplits[0].variationKey == "off");
+        CHECK_FALSE(details.evaluatedSplits[0].matched);
+        CHECK(details.evaluatedSplits[1].variationKey == "on");
+        CHECK(details.evaluatedSplits[1].matched);
+        REQUIRE(details.evaluatedSplits[1].shards.size() == 1);
+        CHECK(details.evaluatedSplits[1].shards[0].matched);
+        CHECK(details.evaluatedSplits[1].shards[0].shard["salt"] == "salt");
+        CHECK(details.evaluatedSplits[1].shards[0].shardValue ==
+              static_cast<uint32_t>(getShard("salt-subject", 10000)));
+    }
+
+    SECTION("Full trace of a plain attribute map") {
+        EvalResultWithDetails result = evalFlagDetails(flag, "subject", attributes, nullptr,
+                                                       EvaluationTraceLevel::FULL);
+        REQUIRE(result.details.allocations.size() == 1);
+        CHECK(result.details.allocations[0].evaluatedRules.size() == 2);
+        CHECK(result.details.allocations[0].evaluatedSplits.size() == 2);
+    }
+
+    SECTION("Traced and untraced evaluation agree") {
+        for (int i = 0; i < 50; ++i) {
+            Attributes subjectAttributes = {{"country", std::string(i % 2 ? "US" : "FR")},
+                                            {"age", int64_t(i)}};
+            SubjectContext s("subject-" + std::to_string(i), subjectAttributes);
+            auto traced = evalFlagDetails(flag, s, nullptr, EvaluationTraceLevel::FULL);
+            auto untraced = evalFlag(flag, s);
+            CHECK(traced.value.has_value() == untraced.has_value());
+            CHECK(traced.details.variationKey == evalFlagDetails(flag, s).details.variationKey);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <catch_amalgamated.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/client.hpp"
+#include "../src/configuration.hpp"
+#include "../src/evaluation_session.hpp"
+#include "beta_flag_fixture.hpp"
+
+using namespace eppoclient;
+
+namespace {
+// Mock assignment logger
+class MockAssignmentLogger : public AssignmentLogger {
+public:
+    std::vector<AssignmentEvent> loggedEvents;
+
+    void logAssignment(const AssignmentEvent& event) override { loggedEvents.push_back(event); }
+};
+}  // namespace
+
+TEST_CASE("EvaluationSession evaluates like the client getters", "[evaluation-session]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    auto assignmentLogger = std::make_shared<MockAssignmentLogger>();
+    EppoClient client(store, assignmentLogger);
+
+    Attributes us = {{"country", std::string("US")}};
+    Attributes fr = {{"country", std::string("FR")}};
+
+    auto session = client.session();
+    CHECK(session.getBooleanAssignment("beta-flag", "alice", us, false) ==
+          client.getBooleanAssignment("beta-flag", "alice", us, false));
+    CHECK(session.getBooleanAssignment("beta-flag", "bob", fr, true) == false);
+    CHECK(session.getStringAssignment("beta-flag", "alice", us, "default") == "default");
+
+    auto details = session.getBooleanAssignmentDetails("beta-flag", "alice", us, false);
+    CHECK(details.variation == true);
+
+    SubjectContext subject(session.getConfiguration(), "carol", us);
+    CHECK(session.getBooleanAssignment("beta-flag", subject, false) == true);
+
+    // Assignment events are logged exactly as with the client getters
+    REQUIRE(assignmentLogger->loggedEvents.size() == 4);
+    CHECK(assignmentLogger->loggedEvents[0].allocation ==
+          assignmentLogger->loggedEvents[1].allocation);
+    CHECK(assignmentLogger->loggedEvents[3].subject == "carol");
+}
+
+TEST_CASE("EvaluationSession keeps its configuration snapshot", "[evaluation-session]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    EppoClient client(store, nullptr, nullptr, nullptr, 100);
+
+    Attributes fr = {{"country", std::string("FR")}};
+
+    auto session = client.session();
+    CHECK(session.getBooleanAssignment("beta-flag", "alice", fr, true) == false);
+
+    store->setConfiguration(test::makeBetaFlagConfiguration("FR"));
+
+    // The session still evaluates against the configuration it was created with
+    CHECK(session.getBooleanAssignment("beta-flag", "alice", fr, true) == false);
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", fr, false) == true);
+
+    // A new session sees the new configuration
+    CHECK(client.session().getBooleanAssignment("beta-flag", "alice", fr, false) == true);
+}
+
+TEST_CASE("Details getters record a full trace on request", "[evaluation-session]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    EppoClient client(store);
+    auto session = client.session();
+
+    Attributes fr = {{"country", std::string("FR")}};
+
+    // Only the allocations are recorded by default
+    auto details = client.getBooleanAssignmentDetails("beta-flag", "alice", fr, true);
+    REQUIRE(details.evaluationDetails.has_value());
+    REQUIRE_FALSE(details.evaluationDetails->allocations.empty());
+    CHECK(details.evaluationDetails->allocations[0].evaluatedRules.empty());
+
+    for (const auto& traced :
+         {client.getBooleanAssignmentDetails("beta-flag", "alice", fr, true,
+                                             EvaluationTraceLevel::FULL),
+          session.getBooleanAssignmentDetails("beta-flag", "alice", fr, true,
+                                              EvaluationTraceLevel::FULL)}) {
+        CHECK(traced.variation == false);
+        REQUIRE(traced.evaluationDetails.has_value());
+        REQUIRE_FALSE(traced.evaluationDetails->allocations.empty());
+        const auto& betaUsers = traced.evaluationDetails->allocations[0];
+        REQUIRE(betaUsers.evaluatedRules.size() == 1);
+        CHECK_FALSE(betaUsers.evaluatedRules[0].matched);
+    }
+}
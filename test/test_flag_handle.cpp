@@ -0,0 +1,133 @@
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/client.hpp"
+#include "../src/configuration.hpp"
+#include "../src/flag_handle.hpp"
+#include "beta_flag_fixture.hpp"
+
+using namespace eppoclient;
+
+namespace {
+// Mock application logger
+class MockApplicationLogger : public ApplicationLogger {
+public:
+    std::vector<std::string> infoMessages;
+    std::vector<std::string> warnMessages;
+    std::vector<std::string> errorMessages;
+
+    void debug(const std::string&) override {}
+
+    void info(const std::string& message) override { infoMessages.push_back(message); }
+
+    void warn(const std::string& message) override { warnMessages.push_back(message); }
+
+    void error(const std::string& message) override { errorMessages.push_back(message); }
+};
+
+// Mock assignment logger
+class MockAssignmentLogger : public AssignmentLogger {
+public:
+    std::vector<AssignmentEvent> loggedEvents;
+
+    void logAssignment(const AssignmentEvent& event) override { loggedEvents.push_back(event); }
+};
+}  // namespace
+
+TEST_CASE("FlagHandle evaluates like the typed getters", "[flag-handle]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    auto assignmentLogger = std::make_shared<MockAssignmentLogger>();
+    EppoClient client(store, assignmentLogger);
+
+    auto beta = client.flag<bool>("beta-flag");
+    CHECK(beta.getFlagKey() == "beta-flag");
+
+    Attributes us = {{"country", std::string("US")}};
+    Attributes fr = {{"country", std::string("FR")}};
+
+    CHECK(beta.getAssignment("alice", us, false) ==
+          client.getBooleanAssignment("beta-flag", "alice", us, false));
+    CHECK(beta.getAssignment("alice", us, false) == true);
+    CHECK(beta.getAssignment("bob", fr, true) == false);
+
+    SubjectContext subject(*store->getConfiguration(), "carol", us);
+    CHECK(beta.getAssignment(subject, false) == true);
+
+    // Assignment events are logged exactly as with the typed getters
+    REQUIRE(assignmentLogger->loggedEvents.size() == 4);
+    CHECK(assignmentLogger->loggedEvents[0].featureFlag == "beta-flag");
+    CHECK(assignmentLogger->loggedEvents[0].allocation ==
+          assignmentLogger->loggedEvents[1].allocation);
+    CHECK(assignmentLogger->loggedEvents[3].subject == "carol");
+}
+
+TEST_CASE("FlagHandle resolves the flag again after a configuration change", "[flag-handle]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    EppoClient client(store);
+
+    auto beta = client.flag<bool>("beta-flag");
+    Attributes fr = {{"country", std::string("FR")}};
+
+    CHECK(beta.getAssignment("alice", fr, false) == false);
+
+    store->setConfiguration(test::makeBetaFlagConfiguration("FR"));
+    CHECK(beta.getAssignment("alice", fr, false) == true);
+
+    store->setConfiguration(Configuration());
+    CHECK(beta.getAssignment("alice", fr, false) == false);
+}
+
+TEST_CASE("FlagHandle uses the client's assignment result cache", "[flag-handle]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    auto assignmentLogger = std::make_shared<MockAssignmentLogger>();
+    EppoClient client(store, assignmentLogger, nullptr, nullptr, 100);
+
+    auto beta = client.flag<bool>("beta-flag");
+    Attributes us = {{"country", std::string("US")}};
+
+    CHECK(client.getBooleanAssignment("beta-flag", "alice", us, false) == true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(beta.getAssignment("alice", us, false) == true);
+    CHECK(beta.getAssignment("alice", us, false) == true);
+
+    // The handle is served from the cache, logging the first evaluation's event again
+    REQUIRE(assignmentLogger->loggedEvents.size() == 3);
+    for (const auto& event : assignmentLogger->loggedEvents) {
+        CHECK(event.timestamp == assignmentLogger->loggedEvents[0].timestamp);
+    }
+}
+
+TEST_CASE("FlagHandle returns the default value on errors", "[flag-handle]") {
+    auto store = std::make_shared<ConfigurationStore>(test::makeBetaFlagConfiguration("US"));
+    auto applicationLogger = std::make_shared<MockApplicationLogger>();
+    EppoClient client(store, nullptr, nullptr, applicationLogger);
+
+    Attributes us = {{"country", std::string("US")}};
+
+    SECTION("Unknown flag") {
+        auto missing = client.flag<bool>("missing-flag");
+        CHECK(missing.getAssignment("alice", us, false) == false);
+        REQUIRE(applicationLogger->infoMessages.size() == 1);
+        CHECK(applicationLogger->infoMessages[0] ==
+              "Failed to get flag configuration for: missing-flag");
+    }
+
+    SECTION("Type mismatch") {
+        auto beta = client.flag<std::string>("beta-flag");
+        CHECK(beta.getAssignment("alice", us, "default") == "default");
+        CHECK(beta.getAssignment("alice", us, "default") == "default");
+        REQUIRE(applicationLogger->warnMessages.size() == 2);
+        CHECK(applicationLogger->warnMessages[0] ==
+              "Failed to verify flag type for: beta-flag (expected: STRING, actual: BOOLEAN)");
+    }
+
+    SECTION("Empty subject key") {
+        auto beta = client.flag<bool>("beta-flag");
+        CHECK(beta.getAssignment("", us, false) == false);
+        REQUIRE(applicationLogger->errorMessages.size() == 1);
+        CHECK(applicationLogger->errorMessages[0] == "No subject key provided");
+    }
+}
@@ -1,6 +1,10 @@
 #include <catch_amalgamated.hpp>
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
+#include "../src/configuration.hpp"
 #include "../src/lru_bandit_logger.hpp"
 
 using namespace eppoclient;
@@ -42,6 +46,77 @@ BanditEvent createTestEvent(const std::string& flagKey = "flag",
     event.timestamp = timestamp;
     return event;
 }
+
+// Bandit logger that drops every action and records the actions it was asked about
+class DroppingBanditLogger : public BanditLogger {
+public:
+    std::vector<std::string> checkedActions;
+    int loggedCount = 0;
+
+    void logBanditAction(const BanditEvent&) override { loggedCount++; }
+
+    bool shouldLogBanditAction(const std::string& flagKey, const std::string& subject,
+                               const std::string& banditKey, const std::string& action) override {
+        checkedActions.push_back(flagKey + "/" + subject + "/" + banditKey + "/" + action);
+        return false;
+    }
+};
+
+std::shared_ptr<const Configuration> makeBanditConfiguration() {
+    std::string flagsJson = R"({
+        "flags": {
+            "shoe-flag": {
+                "key": "shoe-flag",
+                "enabled": true,
+                "variationType": "STRING",
+                "variations": {"bandit": {"key": "bandit", "value": "shoe-bandit"}},
+                "allocations": [{
+                    "key": "everyone",
+                    "splits": [{"variationKey": "bandit", "shards": []}],
+                    "doLog": true
+                }],
+                "totalShards": 10000
+            }
+        },
+        "bandits": {
+            "shoe-bandit": [{
+                "key": "shoe-bandit",
+                "flagKey": "shoe-flag",
+                "variationKey": "bandit",
+                "variationValue": "shoe-bandit"
+            }]
+        }
+    })";
+    std::string banditsJson = R"({
+        "bandits": {
+            "shoe-bandit": {
+                "banditKey": "shoe-bandit",
+                "modelName": "falcon",
+                "modelVersion": "v1",
+                "updatedAt": "2024-01-15T10:30:00Z",
+                "modelData": {
+                    "gamma": 1.0,
+                    "defaultActionScore": 0.0,
+                    "actionProbabilityFloor": 0.0,
+                    "coefficients": {
+                        "nike": {
+                            "actionKey": "nike",
+                            "intercept": 1.5,
+                            "subjectNumericCoefficients": [],
+                            "subjectCategoricalCoefficients": [],
+                            "actionNumericCoefficients": [],
+                            "actionCategoricalCoefficients": []
+                        }
+                    }
+                }
+            }
+        },
+        "updatedAt": "2024-01-15T10:30:00Z"
+    })";
+    auto result = parseConfiguration(flagsJson, banditsJson);
+    REQUIRE(result.hasValue());
+    return std::make_shared<const Configuration>(std::move(*result.value));
+}
 }  // anonymous namespace
 
 TEST_CASE("LruBanditLogger - cache bandit action", "[lru][bandit-logger]") {
@@ -140,6 +215,53 @@ TEST_CASE("LruBanditLogger - timestamp and probabilities are not important",
     CHECK(innerLogger->callCount() == 1);
 }
 
+TEST_CASE("LruBanditLogger - shouldLogBanditAction detects duplicates", "[lru][bandit-logger]") {
+    auto innerLogger = std::make_shared<MockBanditLogger>();
+    auto logger = NewLruBanditLogger(innerLogger, 1000);
+
+    // Checking does not cache the action
+    CHECK(logger->shouldLogBanditAction("flag", "subject", "bandit", "action"));
+    CHECK(logger->shouldLogBanditAction("flag", "subject", "bandit", "action"));
+
+    logger->logBanditAction(createTestEvent("flag", "bandit", "subject", "action"));
+    CHECK_FALSE(logger->shouldLogBanditAction("flag", "subject", "bandit", "action"));
+    CHECK(logger->shouldLogBanditAction("flag", "subject", "bandit", "other-action"));
+    CHECK(logger->shouldLogBanditAction("flag", "other-subject", "bandit", "action"));
+
+    // Actions the inner logger drops are not logged either
+    auto noOpLogger = NewLruBanditLogger(std::make_shared<NoOpBanditLogger>(), 1000);
+    CHECK_FALSE(noOpLogger->shouldLogBanditAction("flag", "subject", "bandit", "action"));
+}
+
+TEST_CASE("EppoClient builds no bandit event for actions the logger drops",
+          "[lru][bandit-logger]") {
+    auto store = std::make_shared<ConfigurationStore>(makeBanditConfiguration());
+    auto innerLogger = std::make_shared<MockBanditLogger>();
+    auto droppingLogger = std::make_shared<DroppingBanditLogger>();
+
+    ContextAttributes subjectAttributes;
+    std::map<std::string, ContextAttributes> actions = {{"nike", ContextAttributes()}};
+
+    // Duplicates are dropped before an event is built
+    EppoClient client(store, nullptr, NewLruBanditLogger(innerLogger, 1000), nullptr);
+    for (int i = 0; i < 3; ++i) {
+        BanditResult result =
+            client.getBanditAction("shoe-flag", "alice", subjectAttributes, actions, "default");
+        CHECK(result.action == std::optional<std::string>("nike"));
+    }
+    REQUIRE(innerLogger->callCount() == 1);
+    CHECK(innerLogger->loggedEvents[0].action == "nike");
+    CHECK(innerLogger->loggedEvents[0].metaData.at("sdkLanguage") == "cpp");
+
+    EppoClient droppingClient(store, nullptr, droppingLogger, nullptr);
+    auto details = droppingClient.getBanditActionDetails("shoe-flag", "bob", subjectAttributes,
+                                                         actions, "default");
+    CHECK(details.action == std::optional<std::string>("nike"));
+    CHECK(droppingLogger->loggedCount == 0);
+    CHECK(droppingLogger->checkedActions ==
+          std::vector<std::string>{"shoe-flag/bob/shoe-bandit/nike"});
+}
+
 // Note: Tests for "exceptions are not cached" and "constructor validation" removed
 // since SDK no longer uses exceptions. Constructors now use assert() for precondition checks:
 // - inner logger must not be null
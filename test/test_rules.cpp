@@ -0,0 +1,141 @@
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include "../src/config_response.hpp"
+#include "../src/rules.hpp"
+
+using namespace eppoclient;
+using namespace eppoclient::internal;
+
+TEST_CASE("Regex matching on string attributes", "[rules]") {
+    auto pattern = std::make_shared<re2::RE2>("@example\\.com$");
+
+    CHECK(matches(AttributeValue(std::string("alice@example.com")), pattern));
+    CHECK_FALSE(matches(AttributeValue(std::string("alice@example.org")), pattern));
+    CHECK_FALSE(matches(AttributeValue(std::string("")), pattern));
+}
+
+TEST_CASE("Regex matching on integer attributes", "[rules]") {
+    CHECK(matches(AttributeValue(int64_t(12345)), std::make_shared<re2::RE2>("^123")));
+    CHECK(matches(AttributeValue(int64_t(-42)), std::make_shared<re2::RE2>("^-42$")));
+    CHECK(matches(AttributeValue(int64_t(0)), std::make_shared<re2::RE2>("^0$")));
+    CHECK(matches(AttributeValue(std::numeric_limits<int64_t>::min()),
+                  std::make_shared<re2::RE2>("^-9223372036854775808$")));
+    CHECK(matches(AttributeValue(std::numeric_limits<int64_t>::max()),
+                  std::make_shared<re2::RE2>("^9223372036854775807$")));
+    CHECK_FALSE(matches(AttributeValue(int64_t(7)), std::make_shared<re2::RE2>("^8$")));
+}
+
+TEST_CASE("Regex matching on boolean attributes", "[rules]") {
+    auto pattern = std::make_shared<re2::RE2>("^true$");
+
+    CHECK(matches(AttributeValue(true), pattern));
+    CHECK_FALSE(matches(AttributeValue(false), pattern));
+    CHECK(matches(AttributeValue(false), std::make_shared<re2::RE2>("^false$")));
+}
+
+TEST_CASE("Regex never matches doubles or null", "[rules]") {
+    auto pattern = std::make_shared<re2::RE2>(".*");
+
+    CHECK_FALSE(matches(AttributeValue(1.5), pattern));
+    CHECK_FALSE(matches(AttributeValue(std::monostate()), pattern));
+    CHECK_FALSE(matches(AttributeValue(std::string("x")), nullptr));
+}
+
+TEST_CASE("Pattern set matching agrees with single patterns", "[rules]") {
+    re2::RE2::Set patterns(re2::RE2::DefaultOptions, re2::RE2::UNANCHORED);
+    REQUIRE(patterns.Add("^1", nullptr) == 0);
+    REQUIRE(patterns.Add("3$", nullptr) == 1);
+    REQUIRE(patterns.Add("^true$", nullptr) == 2);
+    REQUIRE(patterns.Compile());
+
+    auto matched = matchPatternSet(AttributeValue(int64_t(123)), patterns);
+    REQUIRE(matched.has_value());
+    std::sort(matched->begin(), matched->end());
+    CHECK(*matched == std::vector<int>{0, 1});
+
+    matched = matchPatternSet(AttributeValue(true), patterns);
+    REQUIRE(matched.has_value());
+    CHECK(*matched == std::vector<int>{2});
+
+    matched = matchPatternSet(AttributeValue(1.0), patterns);
+    REQUIRE(matched.has_value());
+    CHECK(matched->empty());
+}
+
+namespace {
+Condition makeCondition(Operator op, const std::string& attribute, const nlohmann::json& value) {
+    Condition condition;
+    condition.op = op;
+    condition.attribute = attribute;
+    condition.value = value;
+    condition.precompute();
+    return condition;
+}
+}  // namespace
+
+TEST_CASE("Conditions are ordered by estimated cost", "[rules]") {
+    Rule rule;
+    rule.conditions.push_back(makeCondition(Operator::MATCHES, "email", "@example\\.com$"));
+    rule.conditions.push_back(
+        makeCondition(Operator::ONE_OF, "country", nlohmann::json::array({"US", "CA"})));
+    rule.conditions.push_back(makeCondition(Operator::GTE, "age", 18));
+    rule.conditions.push_back(makeCondition(Operator::IS_NULL, "plan", false));
+    rule.precompute();
+
+    CHECK(rule.conditionOrder == std::vector<size_t>{3, 2, 1, 0});
+
+    // Order does not change the outcome
+    Attributes matching = {{"email", std::string("a@example.com")},
+                           {"country", std::string("US")},
+                           {"age", int64_t(30)},
+                           {"plan", std::string("pro")}};
+    Attributes failing = matching;
+    failing["email"] = std::string("a@example.org");
+    CHECK(ruleMatches(rule, matching));
+    CHECK_FALSE(ruleMatches(rule, failing));
+
+    // Rules without a precomputed order are evaluated in configuration order
+    rule.conditionOrder.clear();
+    CHECK(ruleMatches(rule, matching));
+    CHECK_FALSE(ruleMatches(rule, failing));
+}
+
+TEST_CASE("Conditions are reordered by observed failure rate", "[rules]") {
+    Rule rule;
+    rule.conditions.push_back(makeCondition(Operator::GTE, "age", 18));
+    rule.conditions.push_back(makeCondition(Operator::GTE, "score", 50));
+    for (auto& condition : rule.conditions) {
+        condition.statistics = std::make_shared<ConditionStatistics>();
+    }
+    rule.updateConditionOrder();
+    CHECK(rule.conditionOrder == std::vector<size_t>{0, 1});
+
+    // "age" almost always passes, "score" almost always fails
+    Attributes attributes = {{"age", int64_t(30)}, {"score", int64_t(10)}};
+    for (int i = 0; i < 100; ++i) {
+        CHECK_FALSE(ruleMatches(rule, attributes));
+    }
+    CHECK(rule.conditions[0].statistics->evaluations == 100);
+    CHECK(rule.conditions[0].statistics->failures == 0);
+    CHECK(rule.conditions[1].statistics->failures == 100);
+
+    rule.updateConditionOrder();
+    CHECK(rule.conditionOrder == std::vector<size_t>{1, 0});
+    CHECK_FALSE(ruleMatches(rule, attributes));
+}
+
+TEST_CASE("Rules are ordered by estimated cost", "[rules]") {
+    Rule expensive;
+    expensive.conditions.push_back(makeCondition(Operator::MATCHES, "email", "@example\\.com$"));
+    Rule cheap;
+    cheap.conditions.push_back(makeCondition(Operator::IS_NULL, "plan", true));
+
+    Allocation allocation;
+    allocation.rules = {expensive, cheap};
+    allocation.precompute();
+
+    CHECK(allocation.ruleOrder == std::vector<size_t>{1, 0});
+}
@@ -0,0 +1,465 @@
+#include <catch_amalgamated.hpp>
+#include <string>
+#include "../src/client.hpp"
+#include "../src/configuration.hpp"
+#include "../src/evaluation_client.hpp"
+#include "../src/subject_context.hpp"
+
+using namespace eppoclient;
+
+namespace {
+const char* const kFlagsJson = R"({
+    "flags": {
+        "country-flag": {
+            "key": "country-flag",
+            "enabled": true,
+            "variationType": "STRING",
+            "variations": {
+                "local": {"key": "local", "value": "local"},
+                "global": {"key": "global", "value": "global"}
+            },
+            "allocations": [
+                {
+                    "key": "local-allocation",
+                    "rules": [{"conditions": [
+                        {"attribute": "country", "operator": "ONE_OF", "value": ["US", "CA"]}
+                    ]}],
+                    "splits": [{"variationKey": "local", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "default",
+                    "splits": [{"variationKey": "global", "shards": []}],
+                    "doLog": false
+                }
+            ],
+            "totalShards": 10000
+        },
+        "id-flag": {
+            "key": "id-flag",
+            "enabled": true,
+            "variationType": "BOOLEAN",
+            "variations": {
+                "on": {"key": "on", "value": true},
+                "off": {"key": "off", "value": false}
+            },
+            "allocations": [
+                {
+                    "key": "allow-list",
+                    "rules": [{"conditions": [
+                        {"attribute": "id", "operator": "ONE_OF", "value": ["alice"]}
+                    ]}],
+                    "splits": [{"variationKey": "on", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "default",
+                    "splits": [{"variationKey": "off", "shards": []}],
+                    "doLog": false
+                }
+            ],
+            "totalShards": 10000
+        },
+        "age-flag": {
+            "key": "age-flag",
+            "enabled": true,
+            "variationType": "INTEGER",
+            "variations": {
+                "adult": {"key": "adult", "value": 18},
+                "minor": {"key": "minor", "value": 0}
+            },
+            "allocations": [
+                {
+                    "key": "adults",
+                    "rules": [{"conditions": [
+                        {"attribute": "age", "operator": "GTE", "value": 18},
+                        {"attribute": "country", "operator": "IS_NULL", "value": false}
+                    ]}],
+                    "splits": [{"variationKey": "adult", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "default",
+                    "splits": [{"variationKey": "minor", "shards": []}],
+                    "doLog": false
+                }
+            ],
+            "totalShards": 10000
+        },
+        "version-flag": {
+            "key": "version-flag",
+            "enabled": true,
+            "variationType": "STRING",
+            "variations": {
+                "new": {"key": "new", "value": "new"},
+                "recent": {"key": "recent", "value": "recent"},
+                "old": {"key": "old", "value": "old"}
+            },
+            "allocations": [
+                {
+                    "key": "new-versions",
+                    "rules": [{"conditions": [
+                        {"attribute": "app_version", "operator": "GTE", "value": "2.0.0"}
+                    ]}],
+                    "splits": [{"variationKey": "new", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "recent-versions",
+                    "rules": [{"conditions": [
+                        {"attribute": "app_version", "operator": "GTE", "value": "1.5.0"}
+                    ]}],
+                    "splits": [{"variationKey": "recent", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "default",
+                    "splits": [{"variationKey": "old", "shards": []}],
+                    "doLog": false
+                }
+            ],
+            "totalShards": 10000
+        },
+        "email-flag": {
+            "key": "email-flag",
+            "enabled": true,
+            "variationType": "STRING",
+            "variations": {
+                "internal": {"key": "internal", "value": "internal"},
+                "partner": {"key": "partner", "value": "partner"},
+                "external": {"key": "external", "value": "external"}
+            },
+            "allocations": [
+                {
+                    "key": "internal-users",
+                    "rules": [{"conditions": [
+                        {"attribute": "email", "operator": "MATCHES", "value": "@example\\.com$"}
+                    ]}],
+                    "splits": [{"variationKey": "internal", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "partner-users",
+                    "rules": [{"conditions": [
+                        {"attribute": "email", "operator": "MATCHES", "value": "@partner\\.(com|org)$"},
+                        {"attribute": "email", "operator": "NOT_MATCHES", "value": "^test"}
+                    ]}],
+                    "splits": [{"variationKey": "partner", "shards": []}],
+                    "doLog": false
+                },
+                {
+                    "key": "default",
+                    "splits": [{"variationKey": "external", "shards": []}],
+                    "doLog": false
+                }
+            ],
+            "totalShards": 10000
+        }
+    }
+})";
+
+Configuration loadConfiguration() {
+    auto result = parseConfiguration(kFlagsJson);
+    REQUIRE(result.hasValue());
+    return std::move(*result.value);
+}
+}  // namespace
+
+TEST_CASE("Configuration assigns dense attribute IDs", "[subject-context]") {
+    Configuration config = loadConfiguration();
+
+    const auto& names = config.getAttributeNames();
+    REQUIRE(names.size() == 5);
+
+    for (const auto& name : {"country", "id", "age", "app_version", "email"}) {
+        auto id = config.getAttributeId(name);
+        REQUIRE(id.has_value());
+        REQUIRE(*id < names.size());
+        CHECK(names[*id] == name);
+    }
+    CHECK_FALSE(config.getAttributeId("unknown").has_value());
+
+    // Every condition carries the ID of its attribute
+    const FlagConfiguration* flag = config.getFlagConfiguration("age-flag");
+    REQUIRE(flag != nullptr);
+    for (const auto& condition : flag->allocations[0].rules[0].conditions) {
+        REQUIRE(condition.attributeId.has_value());
+        CHECK(names[*condition.attributeId] == condition.attribute);
+    }
+}
+
+TEST_CASE("SubjectContext resolves attributes", "[subject-context]") {
+    Configuration config = loadConfiguration();
+    Attributes attributes = {{"country", std::string("US")}, {"plan", std::string("pro")}};
+
+    SECTION("Resolved against configuration") {
+        SubjectContext subject(config, "bob", attributes);
+        CHECK(subject.isResolved());
+        CHECK(subject.isResolvedFor(config));
+
+        const Condition& condition =
+            config.getFlagConfiguration("country-flag")->allocations[0].rules[0].conditions[0];
+        const AttributeValue* value = subject.getAttribute(condition);
+        REQUIRE(value != nullptr);
+        CHECK(std::get<std::string>(*value) == "US");
+
+        // Attributes not referenced by any condition are still available by name
+        const AttributeValue* plan = subject.getAttribute("plan");
+        REQUIRE(plan != nullptr);
+        CHECK(std::get<std::string>(*plan) == "pro");
+
+        CHECK(subject.getAttribute("age") == nullptr);
+    }
+
+    SECTION("Looked up by name") {
+        SubjectContext subject("bob", attributes);
+        CHECK_FALSE(subject.isResolved());
+
+        const AttributeValue* value = subject.getAttribute("country");
+        REQUIRE(value != nullptr);
+        CHECK(std::get<std::string>(*value) == "US");
+        CHECK(subject.getAttribute("age") == nullptr);
+    }
+}
+
+TEST_CASE("SubjectContext defaults id to the subject key", "[subject-context]") {
+    Configuration config = loadConfiguration();
+    Attributes noId;
+    Attributes withId = {{"id", std::string("carol")}};
+
+    SubjectContext resolved(config, "alice", noId);
+    REQUIRE(resolved.getAttribute("id") != nullptr);
+    CHECK(std::get<std::string>(*resolved.getAttribute("id")) == "alice");
+
+    SubjectContext byName("alice", noId);
+    REQUIRE(byName.getAttribute("id") != nullptr);
+    CHECK(std::get<std::string>(*byName.getAttribute("id")) == "alice");
+
+    // An explicit id attribute takes precedence over the subject key
+    SubjectContext explicitId(config, "alice", withId);
+    CHECK(std::get<std::string>(*explicitId.getAttribute("id")) == "carol");
+}
+
+TEST_CASE("EvaluationClient evaluates flags with a SubjectContext", "[subject-context]") {
+    Configuration config = loadConfiguration();
+    NoOpAssignmentLogger assignmentLogger;
+    NoOpBanditLogger banditLogger;
+    NoOpApplicationLogger applicationLogger;
+    EvaluationClient client(config, assignmentLogger, banditLogger, applicationLogger);
+
+    struct Subject {
+        std::string key;
+        Attributes attributes;
+    };
+    std::vector<Subject> subjects = {
+        {"alice", {{"country", std::string("US")}, {"age", int64_t(30)}}},
+        {"bob", {{"country", std::string("FR")}, {"age", 17.0}}},
+        {"carol", {{"age", int64_t(40)}}},
+        {"dave", {{"id", std::string("alice")}, {"country", std::string("CA")}}},
+    };
+
+    for (const auto& s : subjects) {
+        SubjectContext subject(config, s.key, s.attributes);
+
+        CHECK(client.getStringAssignment("country-flag", subject, "none") ==
+              client.getStringAssignment("country-flag", s.key, s.attributes, "none"));
+        CHECK(client.getBooleanAssignment("id-flag", subject, false) ==
+              client.getBooleanAssignment("id-flag", s.key, s.attributes, false));
+        CHECK(client.getIntegerAssignment("age-flag", subject, -1) ==
+              client.getIntegerAssignment("age-flag", s.key, s.attributes, -1));
+    }
+
+    SubjectContext alice(config, "alice", subjects[0].attributes);
+    CHECK(client.getStringAssignment("country-flag", alice, "none") == "local");
+    CHECK(client.getBooleanAssignment("id-flag", alice, false) == true);
+    CHECK(client.getIntegerAssignment("age-flag", alice, -1) == 18);
+
+    // Wrong type and unknown flags return the default
+    CHECK(client.getNumericAssignment("age-flag", alice, 1.5) == 1.5);
+    CHECK(client.getStringAssignment("unknown-flag", alice, "none") == "none");
+}
+
+TEST_CASE("SubjectContext from another configuration falls back to name lookup",
+          "[subject-context]") {
+    Configuration config = loadConfiguration();
+    Configuration otherConfig;
+    NoOpAssignmentLogger assignmentLogger;
+    NoOpBanditLogger banditLogger;
+    NoOpApplicationLogger applicationLogger;
+    EvaluationClient client(config, assignmentLogger, banditLogger, applicationLogger);
+
+    Attributes attributes = {{"country", std::string("CA")}};
+    SubjectContext subject(otherConfig, "bob", attributes);
+    CHECK_FALSE(subject.isResolvedFor(config));
+
+    CHECK(client.getStringAssignment("country-flag", subject, "none") == "local");
+}
+
+TEST_CASE("SubjectContext memoizes parsed attribute values", "[subject-context]") {
+    Configuration config = loadConfiguration();
+    const FlagConfiguration* flag = config.getFlagConfiguration("version-flag");
+    REQUIRE(flag != nullptr);
+    const Condition& newVersions = flag->allocations[0].rules[0].conditions[0];
+    const Condition& recentVersions = flag->allocations[1].rules[0].conditions[0];
+
+    Attributes attributes = {{"app_version", std::string("1.8.2")}};
+
+    SECTION("Resolved against configuration") {
+        SubjectContext subject(config, "bob", attributes);
+        const AttributeValue* value = subject.getAttribute(newVersions);
+        REQUIRE(value != nullptr);
+
+        const semver::version<>* semVer = subject.getSemVerValue(newVersions, *value);
+        REQUIRE(semVer != nullptr);
+        semver::version<> expected;
+        REQUIRE(semver::parse("1.8.2", expected));
+        CHECK(*semVer == expected);
+        CHECK(subject.getSemVerValue(recentVersions, *value) == semVer);
+        CHECK_FALSE(subject.getNumericValue(newVersions, *value).has_value());
+
+        CHECK_FALSE(internal::conditionMatches(newVersions, subject));
+        CHECK(internal::conditionMatches(recentVersions, subject));
+    }
+
+    SECTION("Looked up by name") {
+        SubjectContext subject("bob", attributes);
+        const AttributeValue* value = subject.getAttribute(newVersions.attribute);
+        REQUIRE(value != nullptr);
+
+        const semver::version<>* semVer = subject.getSemVerValue(newVersions, *value);
+        REQUIRE(semVer != nullptr);
+        CHECK(subject.getSemVerValue(recentVersions, *value) == semVer);
+
+        CHECK_FALSE(internal::conditionMatches(newVersions, subject));
+        CHECK(internal::conditionMatches(recentVersions, subject));
+    }
+
+    SECTION("Numeric values") {
+        Attributes numericAttributes = {{"app_version", std::string("3.5")}};
+        SubjectContext subject(config, "bob", numericAttributes);
+        const AttributeValue* value = subject.getAttribute(newVersions);
+        REQUIRE(value != nullptr);
+
+        CHECK(subject.getSemVerValue(newVersions, *value) == nullptr);
+        auto numeric = subject.getNumericValue(recentVersions, *value);
+        REQUIRE(numeric.has_value());
+        CHECK(*numeric == 3.5);
+    }
+
+    SECTION("Flag evaluation matches the attributes map path") {
+        NoOpAssignmentLogger assignmentLogger;
+        NoOpBanditLogger banditLogger;
+        NoOpApplicationLogger applicationLogger;
+        EvaluationClient client(config, assignmentLogger, banditLogger, applicationLogger);
+
+        for (const char* version : {"0.9.0", "1.5.0", "1.8.2", "2.0.0", "10.1.0", "abc"}) {
+            Attributes versionAttributes = {{"app_version", std::string(version)}};
+            SubjectContext subject(config, "bob", versionAttributes);
+            CHECK(client.getStringAssignment("version-flag", subject, "none") ==
+                  client.getStringAssignment("version-flag", "bob", versionAttributes, "none"));
+        }
+    }
+}
+
+TEST_CASE("Configuration compiles pattern sets per attribute", "[subject-context]") {
+    Configuration config = loadConfiguration();
+    const FlagConfiguration* flag = config.getFlagConfiguration("email-flag");
+    REQUIRE(flag != nullptr);
+
+    auto emailId = config.getAttributeId("email");
+    REQUIRE(emailId.has_value());
+    const AttributePatternSet* patternSet = config.getAttributePatternSet(*emailId);
+    REQUIRE(patternSet != nullptr);
+    CHECK(patternSet->size == 3);
+
+    for (size_t i = 0; i < 2; ++i) {
+        for (const auto& condition : flag->allocations[i].rules[0].conditions) {
+            REQUIRE(condition.patternSetIndex.has_value());
+            CHECK(*condition.patternSetIndex < patternSet->size);
+        }
+    }
+
+    // Attributes without regex conditions have no pattern set
+    CHECK(config.getAttributePatternSet(*config.getAttributeId("country")) == nullptr);
+
+    // The flag matches several patterns of the set, so plain attribute maps are
+    // resolved to use it
+    CHECK(flag->usesPatternSets);
+    CHECK_FALSE(config.getFlagConfiguration("country-flag")->usesPatternSets);
+
+    NoOpAssignmentLogger assignmentLogger;
+    NoOpBanditLogger banditLogger;
+    NoOpApplicationLogger applicationLogger;
+    EvaluationClient client(config, assignmentLogger, banditLogger, applicationLogger);
+
+    std::vector<std::pair<AttributeValue, std::string>> cases = {
+        {std::string("alice@example.com"), "internal"},
+        {std::string("bob@partner.org"), "partner"},
+        {std::string("test-bob@partner.com"), "external"},
+        {std::string("carol@elsewhere.com"), "external"},
+        {int64_t(42), "external"},
+        {3.5, "external"},
+    };
+    for (const auto& [email, expected] : cases) {
+        Attributes attributes = {{"email", email}};
+        SubjectContext subject(config, "subject", attributes);
+
+        const Condition& internalUsers = flag->allocations[0].rules[0].conditions[0];
+        const AttributeValue* value = subject.getAttribute(internalUsers);
+        REQUIRE(value != nullptr);
+        auto matched = subject.matchesPattern(internalUsers, *value);
+        REQUIRE(matched.has_value());
+        CHECK(*matched == internal::matches(*value, internalUsers.regexValue));
+
+        CHECK(client.getStringAssignment("email-flag", subject, "none") == expected);
+        CHECK(client.getStringAssignment("email-flag", "subject", attributes, "none") == expected);
+    }
+}
+
+TEST_CASE("Flags matching a single pattern of a set do not use it", "[subject-context]") {
+    // Each flag has one regex condition, so the "email" pattern set spans both flags
+    auto makeFlag = [](const std::string& flagKey, const std::string& pattern) {
+        nlohmann::json condition = {
+            {"attribute", "email"}, {"operator", "MATCHES"}, {"value", pattern}};
+        nlohmann::json variations = {{"on", {{"key", "on"}, {"value", true}}},
+                                     {"off", {{"key", "off"}, {"value", false}}}};
+        return nlohmann::json{
+            {"key", flagKey},
+            {"enabled", true},
+            {"variationType", "BOOLEAN"},
+            {"variations", variations},
+            {"allocations",
+             {{{"key", "matching"},
+               {"rules", {{{"conditions", {condition}}}}},
+               {"splits", {{{"variationKey", "on"}, {"shards", nlohmann::json::array()}}}},
+               {"doLog", false}},
+              {{"key", "default"},
+               {"splits", {{{"variationKey", "off"}, {"shards", nlohmann::json::array()}}}},
+               {"doLog", false}}}},
+            {"totalShards", 10000}};
+    };
+    nlohmann::json flags = {{"flags",
+                             {{"example-flag", makeFlag("example-flag", "@example\\.com$")},
+                              {"partner-flag", makeFlag("partner-flag", "@partner\\.org$")}}}};
+    auto result = parseConfiguration(flags.dump());
+    REQUIRE(result.hasValue());
+    const Configuration& config = *result.value;
+
+    auto emailId = config.getAttributeId("email");
+    REQUIRE(emailId.has_value());
+    REQUIRE(config.getAttributePatternSet(*emailId) != nullptr);
+    CHECK_FALSE(config.getFlagConfiguration("example-flag")->usesPatternSets);
+    CHECK_FALSE(config.getFlagConfiguration("partner-flag")->usesPatternSets);
+
+    NoOpAssignmentLogger assignmentLogger;
+    NoOpBanditLogger banditLogger;
+    NoOpApplicationLogger applicationLogger;
+    EvaluationClient client(config, assignmentLogger, banditLogger, applicationLogger);
+
+    Attributes attributes = {{"email", std::string("alice@partner.org")}};
+    SubjectContext subject(config, "alice", attributes);
+    CHECK(client.getBooleanAssignment("partner-flag", "alice", attributes, false) == true);
+    CHECK(client.getBooleanAssignment("example-flag", "alice", attributes, true) == false);
+    CHECK(client.getBooleanAssignment("partner-flag", subject, false) == true);
+    CHECK(client.getBooleanAssignment("example-flag", subject, true) == false);
+}
@@ -1,4 +1,8 @@
 #include "picohash.h"
+#include "md5_wrapper.h"
+
+// Fails to compile if md5_state cannot hold the picohash MD5 context
+typedef char md5_state_size_check[sizeof(_picohash_md5_ctx_t) <= sizeof(md5_state) ? 1 : -1];
 
 void md5_hash(const void* data, size_t length, unsigned char* digest) {
     _picohash_md5_ctx_t ctx;
@@ -6,3 +10,15 @@ void md5_hash(const void* data, size_t length, unsigned char* digest) {
     _picohash_md5_update(&ctx, data, length);
     _picohash_md5_final(&ctx, digest);
 }
+
+void md5_init(md5_state* state) {
+    _picohash_md5_init((_picohash_md5_ctx_t*)state->bytes);
+}
+
+void md5_update(md5_state* state, const void* data, size_t length) {
+    _picohash_md5_update((_picohash_md5_ctx_t*)state->bytes, data, length);
+}
+
+void md5_final(md5_state* state, unsigned char* digest) {
+    _picohash_md5_final((_picohash_md5_ctx_t*)state->bytes, digest);
+}
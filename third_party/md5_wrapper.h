@@ -11,6 +11,18 @@ extern "C" {
 
 void md5_hash(const void* data, size_t length, unsigned char* digest);
 
+// Incremental MD5. The state is a plain value: copying it after hashing a
+// prefix lets several inputs sharing that prefix be hashed without rehashing it.
+typedef union md5_state {
+    unsigned char bytes[320];
+    void* align_pointer;
+    unsigned long long align_integer;
+} md5_state;
+
+void md5_init(md5_state* state);
+void md5_update(md5_state* state, const void* data, size_t length);
+void md5_final(md5_state* state, unsigned char* digest);
+
 #ifdef __cplusplus
 }
 #endif